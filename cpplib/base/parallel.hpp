@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+
+// parallel code paths are enabled only when compiled with OpenMP support (-fopenmp),
+// otherwise OMP_PRAGMA expands to nothing and all "parallel" loops run sequentially
+#ifdef _OPENMP
+#include <omp.h>
+#define OMP_PRAGMA(...) _Pragma(#__VA_ARGS__)
+#else
+#define OMP_PRAGMA(...)
+#endif
+
+inline std::size_t parallel_threads_count() {
+#ifdef _OPENMP
+    return static_cast<std::size_t>(omp_get_max_threads());
+#else
+    return 1;
+#endif
+}
+
+inline std::size_t parallel_thread_id() {
+#ifdef _OPENMP
+    return static_cast<std::size_t>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "maths/bits.hpp"
+
+class DynamicBitset {
+// Bitset with the size chosen at runtime, keeps the same word layout as Bitset<N>
+public:
+    using value_type = uint64_t;
+    using size_type = std::size_t;
+    using container_type = std::vector<value_type>;
+
+    static constexpr size_type kValueBitWidth = std::numeric_limits<value_type>::digits;
+    static constexpr size_type kIndexMask = kValueBitWidth - 1;
+    static constexpr size_type kIndexPower = binary_power(kValueBitWidth);
+
+    DynamicBitset() : DynamicBitset(0) {}
+
+    explicit DynamicBitset(const size_type size) {
+        init(size);
+    }
+
+    static constexpr size_type words_count(const size_type size) {
+        return (size + kIndexMask) >> kIndexPower;
+    }
+
+    void init(const size_type size) {
+        size_ = size;
+        data_.assign(words_count(size_), 0);
+    }
+
+    DynamicBitset& set(const size_type index) {
+        data_[index >> kIndexPower] |= bit(index);
+        return *this;
+    }
+
+    DynamicBitset& flip(const size_type index) {
+        data_[index >> kIndexPower] ^= bit(index);
+        return *this;
+    }
+
+    DynamicBitset& clear(const size_type index) {
+        data_[index >> kIndexPower] &= ~bit(index);
+        return *this;
+    }
+
+    bool get(const size_type index) const {
+        return (data_[index >> kIndexPower] & bit(index)) != 0;
+    }
+
+    bool operator[](const size_type index) const {
+        return get(index);
+    }
+
+    container_type& data() {
+        return data_;
+    }
+
+    const container_type& data() const {
+        return data_;
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    size_type words_count() const {
+        return data_.size();
+    }
+
+    bool any() const {
+        return std::any_of(data_.cbegin(), data_.cend(), [](const value_type x) {
+            return x != 0;
+        });
+    }
+
+    bool none() const {
+        return !any();
+    }
+
+    void swap(DynamicBitset& rhs) {
+        data_.swap(rhs.data_);
+        std::swap(size_, rhs.size_);
+    }
+
+    DynamicBitset& reset() {
+        std::fill(data_.begin(), data_.end(), 0);
+        return *this;
+    }
+
+    DynamicBitset& set() {
+        std::fill(data_.begin(), data_.end(), std::numeric_limits<value_type>::max());
+        trim();
+        return *this;
+    }
+
+    DynamicBitset& flip() {
+        std::transform(data_.cbegin(), data_.cend(), data_.begin(), [](const value_type value) {
+            return ~value;
+        });
+        trim();
+        return *this;
+    }
+
+    size_type count() const {
+        return std::accumulate(data_.cbegin(), data_.cend(), static_cast<size_type>(0), [](const size_type acc, const value_type value) {
+            return acc + popcount(value);
+        });
+    }
+
+    bool operator ==(const DynamicBitset& rhs) const {
+        return size_ == rhs.size_ && data_ == rhs.data_;
+    }
+
+    bool operator !=(const DynamicBitset& rhs) const {
+        return !operator==(rhs);
+    }
+
+    DynamicBitset& operator &=(const DynamicBitset& rhs) {
+        for (size_type i = 0; i < data_.size(); ++i) {
+            data_[i] &= rhs.data_[i];
+        }
+        return *this;
+    }
+
+    DynamicBitset& operator |=(const DynamicBitset& rhs) {
+        for (size_type i = 0; i < data_.size(); ++i) {
+            data_[i] |= rhs.data_[i];
+        }
+        return *this;
+    }
+
+    DynamicBitset& operator ^=(const DynamicBitset& rhs) {
+        for (size_type i = 0; i < data_.size(); ++i) {
+            data_[i] ^= rhs.data_[i];
+        }
+        return *this;
+    }
+
+    size_type first_bit_from(const size_type index) const {
+        if (index >= size_) {
+            return size_;
+        }
+        size_type word = index >> kIndexPower;
+        value_type value = data_[word] & (std::numeric_limits<value_type>::max() << (index & kIndexMask));
+        while (value == 0) {
+            if (++word == data_.size()) {
+                return size_;
+            }
+            value = data_[word];
+        }
+        return (word << kIndexPower) + countr_zero(value);
+    }
+
+    size_type first_bit_after(const size_type index) const {
+        return first_bit_from(index + 1);
+    }
+
+    size_type least_significant_bit() const {
+        return first_bit_from(0);
+    }
+
+    std::vector<size_type> indices() const {
+        std::vector<size_type> res;
+        for (size_type index = least_significant_bit(); index < size_; index = first_bit_after(index)) {
+            res.emplace_back(index);
+        }
+        return res;
+    }
+
+private:
+    container_type data_;
+    size_type size_;
+
+    static constexpr value_type bit(const size_type index) {
+        return static_cast<value_type>(1) << (index & kIndexMask);
+    }
+
+    void trim()
+    // keeps bits after size() zeroed, so count() and comparisons stay exact
+    {
+        if ((size_ & kIndexMask) != 0) {
+            data_.back() &= bit(size_) - 1;
+        }
+    }
+};
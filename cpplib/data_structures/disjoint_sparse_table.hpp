@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "maths/bits.hpp"
+
+template<typename T, typename Combine>
+class DisjointSparseTable {
+// static range products for any associative combine, no idempotence or commutativity is needed.
+// On level k the array is cut into blocks of 2^(k + 1) elements, the left half of every block stores
+// the products up to its middle and the right half the products from it. A range whose ends first differ
+// in bit k crosses the middle of their common block of level k, so it is one combine of two stored values.
+// Levels are stored one after another in a flat array, n log n values. Ranges are [left, right)
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using combine_type = Combine;
+    using container_type = std::vector<value_type>;
+
+    explicit DisjointSparseTable(container_type data, const combine_type& combine = combine_type()) :
+            data_(std::move(data)),
+            combine_(combine)
+    {
+        build();
+    }
+
+    template<typename Iterator>
+    DisjointSparseTable(Iterator first, Iterator last, const combine_type& combine = combine_type()) :
+            DisjointSparseTable(container_type(first, last), combine)
+    {}
+
+    size_type size() const {
+        return data_.size();
+    }
+
+    const container_type& data() const {
+        return data_;
+    }
+
+    value_type query(const size_type left, const size_type right) const
+    // product of range [left, right), which should be non-empty
+    {
+        const size_type last = right - 1;
+        if (left == last) {
+            return data_[left];
+        }
+        const size_type level = std::numeric_limits<size_type>::digits - 1 - countl_zero(left ^ last);
+        const value_type* table = table_.data() + level * data_.size();
+        return combine_(table[left], table[last]);
+    }
+
+private:
+    container_type data_;
+    const combine_type combine_;
+    container_type table_;
+
+    void build() {
+        const size_type n = data_.size();
+        if (n < 2) {
+            return;
+        }
+        const size_type levels = bit_width(n - 1);
+        table_.reserve(levels * n);
+        for (size_type level = 0; level < levels; ++level) {
+            const size_type half = static_cast<size_type>(1) << level;
+            table_.insert(table_.end(), data_.cbegin(), data_.cend());
+            value_type* table = table_.data() + level * n;
+            for (size_type mid = half; mid < n; mid += 2 * half) {
+                for (size_type i = mid - 1; i-- > mid - half; ) {
+                    table[i] = combine_(data_[i], table[i + 1]);
+                }
+                const size_type end = std::min(mid + half, n);
+                for (size_type i = mid + 1; i < end; ++i) {
+                    table[i] = combine_(table[i - 1], data_[i]);
+                }
+            }
+        }
+    }
+};
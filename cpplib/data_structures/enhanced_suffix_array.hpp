@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "suffix_array.hpp"
+
+template<typename Char = char>
+class EnhancedSuffixArray {
+// suffix array with the LCP array and the child table (Abouelhoda, Kurtz, Ohlebusch), which together replace
+// a suffix tree: lcp-intervals are its inner nodes and their child intervals are enumerated in O(alphabet).
+// lcp_[i] is the LCP of the suffixes sa_[i - 1] and sa_[i], lcp_[0] = lcp_[n] = -1 are sentinels.
+// The up, down and next l-index tables are packed into the single array child_, so everything takes
+// three 32-bit arrays besides the text. SA ranges are half-open
+public:
+    using char_type = Char;
+    using index_type = int32_t;
+    using interval_type = std::pair<index_type, index_type>;
+
+    EnhancedSuffixArray(const char_type* s, const index_type n, const index_type alphabet) :
+            text_(s, s + n),
+            sa_(n),
+            lcp_(n + 1),
+            child_(n + 1, 0)
+    {
+        SuffixArraySais().build(s, n, alphabet, sa_.data());
+        build_lcp(s, n, sa_.data(), lcp_.data());
+        lcp_[0] = -1;
+        lcp_[n] = -1;
+        build_child_table();
+    }
+
+    explicit EnhancedSuffixArray(const std::basic_string<char_type>& s, const index_type alphabet = 256) :
+            EnhancedSuffixArray(s.data(), static_cast<index_type>(s.length()), alphabet)
+    {}
+
+    template<typename CharIn>
+    static void build_lcp(const CharIn* s, const index_type n, const index_type* sa, index_type* lcp)
+    // Kasai's algorithm in O(n): lcp[i] is the LCP of the suffixes sa[i - 1] and sa[i] for i in [1, n), lcp[0] = 0
+    {
+        std::vector<index_type> rank(n);
+        for (index_type i = 0; i < n; ++i) {
+            rank[sa[i]] = i;
+        }
+        if (n > 0) {
+            lcp[0] = 0;
+        }
+        for (index_type i = 0, k = 0; i < n; ++i) {
+            if (rank[i] == 0) {
+                k = 0;
+                continue;
+            }
+            const index_type j = sa[rank[i] - 1];
+            while (i + k < n && j + k < n && s[i + k] == s[j + k]) {
+                ++k;
+            }
+            lcp[rank[i]] = k;
+            if (k > 0) {
+                --k;
+            }
+        }
+    }
+
+    index_type size() const {
+        return static_cast<index_type>(sa_.size());
+    }
+
+    const std::vector<index_type>& sa() const {
+        return sa_;
+    }
+
+    const std::vector<index_type>& lcp() const {
+        return lcp_;
+    }
+
+    interval_type root() const {
+        return interval_type(0, size());
+    }
+
+    index_type lcp_value(const interval_type& interval) const
+    // length of the common prefix of all suffixes of a non-singleton interval
+    {
+        return lcp_[first_l_index(interval.first, interval.second - 1)];
+    }
+
+    template<typename Callback>
+    void for_each_child(const interval_type& interval, Callback callback) const
+    // calls callback(child) for the child intervals of a non-singleton interval from left to right
+    {
+        const index_type i = interval.first;
+        const index_type j = interval.second - 1;
+        index_type left = i;
+        for (index_type k = first_l_index(i, j); ; ) {
+            callback(interval_type(left, k));
+            left = k;
+            if (!is_next_l_index(k, j)) {
+                break;
+            }
+            k = child_[k];
+        }
+        callback(interval_type(left, j + 1));
+    }
+
+    interval_type find(const char_type* pattern, const index_type m) const
+    // range of the suffixes starting with the pattern, empty if there are none; the empty pattern gives root().
+    // Children of an lcp-interval are ordered by their next char and are only reachable one by one through
+    // the child table, so every step scans them up to the first match: O(m alphabet) in the worst case.
+    // O(m) would need a lookup table per inner node, which the three arrays of the layout do not have
+    {
+        if (size() == 0) {
+            return interval_type(0, 0);
+        }
+        interval_type interval = root();
+        for (index_type matched = 0; ; ) {
+            const index_type depth = (interval.second - interval.first == 1 ?
+                    size() - sa_[interval.first] : lcp_value(interval));
+            const index_type end = std::min(depth, m);
+            const char_type* text = text_.data() + sa_[interval.first];
+            for (; matched < end; ++matched) {
+                if (text[matched] != pattern[matched]) {
+                    return interval_type(0, 0);
+                }
+            }
+            if (matched == m) {
+                return interval;
+            }
+            if (interval.second - interval.first == 1) {
+                return interval_type(0, 0);
+            }
+            interval = find_child(interval, depth, pattern[matched]);
+            if (interval.first == interval.second) {
+                return interval;
+            }
+        }
+    }
+
+    interval_type find(const std::basic_string<char_type>& pattern) const {
+        return find(pattern.data(), static_cast<index_type>(pattern.length()));
+    }
+
+    index_type count(const std::basic_string<char_type>& pattern) const {
+        const interval_type interval = find(pattern);
+        return interval.second - interval.first;
+    }
+
+    template<typename Callback>
+    void traverse_bottom_up(Callback callback) const
+    // calls callback(lcp_value, interval) for every lcp-interval (inner node), children before their parent
+    {
+        struct Frame {
+            index_type lcp;
+            index_type left;
+        };
+        std::vector<Frame> stack;
+        stack.emplace_back(Frame{-1, 0});
+        for (index_type i = 1; i <= size(); ++i) {
+            index_type left = i - 1;
+            while (lcp_[i] < stack.back().lcp) {
+                const Frame frame = stack.back();
+                stack.pop_back();
+                callback(frame.lcp, interval_type(frame.left, i));
+                left = frame.left;
+            }
+            if (lcp_[i] > stack.back().lcp) {
+                stack.emplace_back(Frame{lcp_[i], left});
+            }
+        }
+    }
+
+private:
+    std::vector<char_type> text_;
+    std::vector<index_type> sa_;
+    std::vector<index_type> lcp_;
+    // child_[k] is next l-index of k if it exists, otherwise down of k; child_[k - 1] is up of k.
+    // The three never collide, and they are told apart by comparing positions and lcp values
+    std::vector<index_type> child_;
+
+    index_type first_l_index(const index_type i, const index_type j) const {
+        const index_type up = child_[j];
+        return (i < up && up <= j) ? up : child_[i];
+    }
+
+    bool is_next_l_index(const index_type k, const index_type j) const {
+        const index_type next = child_[k];
+        return k < next && next <= j && lcp_[next] == lcp_[k];
+    }
+
+    static auto key(const char_type c) -> typename std::make_unsigned<char_type>::type {
+        return static_cast<typename std::make_unsigned<char_type>::type>(c);
+    }
+
+    interval_type find_child(const interval_type& interval, const index_type depth, const char_type c) const
+    // child interval of a non-singleton interval whose suffixes have c at depth, empty if there is none.
+    // Stops at the first child with a char not less than c, the same order in which SuffixArraySais sorts them
+    {
+        const index_type j = interval.second - 1;
+        index_type left = interval.first;
+        for (index_type k = first_l_index(interval.first, j); ; k = child_[k]) {
+            const index_type position = sa_[left] + depth;
+            if (position < size() && key(text_[position]) >= key(c)) {
+                return text_[position] == c ? interval_type(left, k) : interval_type(0, 0);
+            }
+            left = k;
+            if (!is_next_l_index(k, j)) {
+                break;
+            }
+        }
+        return text_[sa_[left] + depth] == c ? interval_type(left, j + 1) : interval_type(0, 0);
+    }
+
+    void build_child_table() {
+        const index_type n = size();
+        std::vector<index_type> stack;
+        stack.emplace_back(0);
+        for (index_type i = 1, last = -1; i <= n; ++i) {
+            while (lcp_[i] < lcp_[stack.back()]) {
+                last = stack.back();
+                stack.pop_back();
+                const index_type top = stack.back();
+                if (lcp_[i] <= lcp_[top] && lcp_[top] != lcp_[last]) {
+                    child_[top] = last;
+                }
+            }
+            if (last != -1) {
+                child_[i - 1] = last;
+                last = -1;
+            }
+            stack.emplace_back(i);
+        }
+        stack.assign(1, 0);
+        for (index_type i = 1; i <= n; ++i) {
+            while (lcp_[i] < lcp_[stack.back()]) {
+                stack.pop_back();
+            }
+            if (lcp_[i] == lcp_[stack.back()]) {
+                child_[stack.back()] = i;
+                stack.pop_back();
+            }
+            stack.emplace_back(i);
+        }
+    }
+};
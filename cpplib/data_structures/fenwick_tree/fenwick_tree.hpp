@@ -3,8 +3,11 @@
 #include <cstdint>
 #include <cstdlib>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "maths/bits.hpp"
+
 template<typename T>
 class FenwickTreeSum {
 public:
@@ -79,6 +82,59 @@ public:
                 res -= data_[l];
             }
         }
+        return res;
+    }
+
+    void inc(const std::vector<std::pair<size_type, value_type>>& updates)
+    // applies a batch of (index, delta) point updates in O(n + k) by pushing the deltas up the tree in one pass,
+    // small batches with k log n < n fall back to k separate updates
+    {
+        if (updates.size() * bit_width(data_.size()) < data_.size()) {
+            for (const auto& update : updates) {
+                inc(update.first, update.second);
+            }
+            return;
+        }
+        container_type delta(data_.size(), 0);
+        for (const auto& update : updates) {
+            delta[update.first] += update.second;
+        }
+        for (size_type i = 0; i < data_.size(); ++i) {
+            const size_type tree_index = (i | (i + 1));
+            if (tree_index < data_.size()) {
+                delta[tree_index] += delta[i];
+            }
+            data_[i] += delta[i];
+        }
+    }
+
+    void query(const std::vector<size_type>& indices, std::vector<value_type>* results) const
+    // appends the sums for ranges [0, index] of indices sorted in non-decreasing order to results.
+    // Every answer extends the previous one by the sum between neighbouring indices, which walks only
+    // the part of the two paths below their common node, so the whole batch takes O(k log(n / k))
+    {
+        value_type prefix = 0;
+        size_type previous = 0;
+        for (const size_type index : indices) {
+            prefix += query(previous, index);
+            previous = index + 1;
+            results->emplace_back(prefix);
+        }
+    }
+
+    [[nodiscard]] size_type lower_bound(value_type value) const
+    // returns the smallest index such that the sum for range [0, index] is not less than value,
+    // or size() if there is no such index; all elements have to be non-negative
+    {
+        size_type pos = 0;
+        for (size_type step = bit_floor(data_.size()); step > 0; step >>= 1) {
+            const size_type next = pos + step;
+            if (next <= data_.size() && data_[next - 1] < value) {
+                value -= data_[next - 1];
+                pos = next;
+            }
+        }
+        return pos;
     }
 
 private:
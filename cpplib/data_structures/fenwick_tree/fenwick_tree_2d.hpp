@@ -68,3 +68,168 @@ public:
 private:
     container_type data_;
 };
+
+template<typename T>
+class FenwickTreeSum2DFlat {
+// same interface as FenwickTreeSum2D, the n x m tree is stored row-major in one buffer
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using container_type = std::vector<value_type>;
+
+    explicit FenwickTreeSum2DFlat(const size_type n, const size_type m) : rows_(n), cols_(m), data_(n * m, 0) {}
+
+    void clear() {
+        data_.assign(data_.size(), 0);
+    }
+
+    size_type rows() const {
+        return rows_;
+    }
+
+    size_type cols() const {
+        return cols_;
+    }
+
+    container_type& data() {
+        return data_;
+    }
+
+    const container_type& data() const {
+        return data_;
+    }
+
+    void inc(const size_type x, const size_type y, const value_type delta) {
+        for (size_type v = x; v < rows_; v = (v | (v + 1))) {
+            value_type* row = data_.data() + v * cols_;
+            for (size_type u = y; u < cols_; u = (u | (u + 1))) {
+                row[u] += delta;
+            }
+        }
+    }
+
+    value_type query(const size_type x, const size_type y) const
+    // returns sum for range {0, 0}..{x, y}
+    {
+        value_type res = 0;
+        for (int32_t v = x; v >= 0; v = (v & (v + 1)) - 1) {
+            const value_type* row = data_.data() + v * cols_;
+            for (int32_t u = y; u >= 0; u = (u & (u + 1)) - 1) {
+                res += row[u];
+            }
+        }
+        return res;
+    }
+
+    value_type query(const size_type x1, const size_type y1, const size_type x2, const size_type y2) const
+    // returns sum for range {x1, y1}..{x2, y2}
+    {
+        if (x1 > x2 || y1 > y2) {
+            return 0;
+        }
+        const value_type res_down_right = query(x2, y2);
+        const value_type res_up_left = (x1 == 0 || y1 == 0 ? 0 : query(x1 - 1, y1 - 1));
+        const value_type res_down_left = (y1 == 0 ? 0 : query(x2, y1 - 1));
+        const value_type res_up_right = (x1 == 0 ? 0 : query(x1 - 1, y2));
+        return res_down_right + res_up_left - res_down_left - res_up_right;
+    }
+
+private:
+    size_type rows_;
+    size_type cols_;
+    container_type data_;
+};
+
+template<typename T>
+class FenwickTreeSumRangeUpdates2D {
+// rectangle add and rectangle sum. A rectangle add becomes four point updates of the difference array d,
+// and the sum over {0, 0}..{x, y} is (x + 1)(y + 1) sum(d) - (y + 1) sum(d i) - (x + 1) sum(d j) + sum(d i j),
+// so four trees are kept. They are interleaved cell by cell in one buffer, every node visit touches one cache line
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using container_type = std::vector<value_type>;
+
+    explicit FenwickTreeSumRangeUpdates2D(const size_type n, const size_type m) : rows_(n), cols_(m), data_(n * m * 4, 0) {}
+
+    void clear() {
+        data_.assign(data_.size(), 0);
+    }
+
+    size_type rows() const {
+        return rows_;
+    }
+
+    size_type cols() const {
+        return cols_;
+    }
+
+    void update(const size_type x1, const size_type y1, const size_type x2, const size_type y2, const value_type delta)
+    // adds delta to every cell of range {x1, y1}..{x2, y2}
+    {
+        if (x1 > x2 || y1 > y2) {
+            return;
+        }
+        update_impl(x1, y1, delta);
+        update_impl(x1, y2 + 1, -delta);
+        update_impl(x2 + 1, y1, -delta);
+        update_impl(x2 + 1, y2 + 1, delta);
+    }
+
+    value_type query(const size_type x, const size_type y) const
+    // returns sum for range {0, 0}..{x, y}
+    {
+        value_type sum = 0;
+        value_type sum_i = 0;
+        value_type sum_j = 0;
+        value_type sum_ij = 0;
+        for (int32_t v = x; v >= 0; v = (v & (v + 1)) - 1) {
+            const value_type* row = data_.data() + v * cols_ * 4;
+            for (int32_t u = y; u >= 0; u = (u & (u + 1)) - 1) {
+                const value_type* cell = row + u * 4;
+                sum += cell[0];
+                sum_i += cell[1];
+                sum_j += cell[2];
+                sum_ij += cell[3];
+            }
+        }
+        const value_type rows_count = static_cast<value_type>(x + 1);
+        const value_type cols_count = static_cast<value_type>(y + 1);
+        return rows_count * cols_count * sum - cols_count * sum_i - rows_count * sum_j + sum_ij;
+    }
+
+    value_type query(const size_type x1, const size_type y1, const size_type x2, const size_type y2) const
+    // returns sum for range {x1, y1}..{x2, y2}
+    {
+        if (x1 > x2 || y1 > y2) {
+            return 0;
+        }
+        const value_type res_down_right = query(x2, y2);
+        const value_type res_up_left = (x1 == 0 || y1 == 0 ? 0 : query(x1 - 1, y1 - 1));
+        const value_type res_down_left = (y1 == 0 ? 0 : query(x2, y1 - 1));
+        const value_type res_up_right = (x1 == 0 ? 0 : query(x1 - 1, y2));
+        return res_down_right + res_up_left - res_down_left - res_up_right;
+    }
+
+private:
+    size_type rows_;
+    size_type cols_;
+    // cell {v, u} holds the trees of d, d i, d j and d i j at 4 (v cols + u) .. 4 (v cols + u) + 3
+    container_type data_;
+
+    void update_impl(const size_type x, const size_type y, const value_type delta) {
+        const value_type delta_i = delta * static_cast<value_type>(x);
+        const value_type delta_j = delta * static_cast<value_type>(y);
+        const value_type delta_ij = delta_i * static_cast<value_type>(y);
+        for (size_type v = x; v < rows_; v = (v | (v + 1))) {
+            value_type* row = data_.data() + v * cols_ * 4;
+            for (size_type u = y; u < cols_; u = (u | (u + 1))) {
+                value_type* cell = row + u * 4;
+                cell[0] += delta;
+                cell[1] += delta_i;
+                cell[2] += delta_j;
+                cell[3] += delta_ij;
+            }
+        }
+    }
+};
@@ -0,0 +1,138 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template<typename T, typename Coordinate = int64_t>
+class CompressedFenwickTreeSum2D {
+// offline 2D Fenwick tree for sparse points: all update points are registered with add_point() before build().
+// The outer tree is over the sorted distinct x, every outer node keeps the sorted distinct y of the points
+// under it together with a 1D Fenwick tree over them, so k points take O(k log k) memory.
+// Queries accept any coordinates, ranges are inclusive as in FenwickTreeSum2D
+public:
+    using value_type = T;
+    using coordinate_type = Coordinate;
+    using size_type = std::size_t;
+
+    void add_point(const coordinate_type x, const coordinate_type y) {
+        points_.emplace_back(x, y);
+    }
+
+    void build() {
+        xs_.clear();
+        for (const auto& point : points_) {
+            xs_.emplace_back(point.first);
+        }
+        std::sort(xs_.begin(), xs_.end());
+        xs_.erase(std::unique(xs_.begin(), xs_.end()), xs_.end());
+
+        std::vector<size_type> offsets(xs_.size() + 1, 0);
+        for (const auto& point : points_) {
+            for (size_type v = x_index(point.first); v < xs_.size(); v = (v | (v + 1))) {
+                ++offsets[v + 1];
+            }
+        }
+        for (size_type v = 0; v < xs_.size(); ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        std::vector<coordinate_type> ys(offsets.back());
+        std::vector<size_type> fill(offsets.cbegin(), offsets.cend() - 1);
+        for (const auto& point : points_) {
+            for (size_type v = x_index(point.first); v < xs_.size(); v = (v | (v + 1))) {
+                ys[fill[v]++] = point.second;
+            }
+        }
+
+        offsets_.assign(xs_.size() + 1, 0);
+        ys_.clear();
+        for (size_type v = 0; v < xs_.size(); ++v) {
+            const auto first = ys.begin() + offsets[v];
+            const auto last = ys.begin() + offsets[v + 1];
+            std::sort(first, last);
+            ys_.insert(ys_.end(), first, std::unique(first, last));
+            offsets_[v + 1] = ys_.size();
+        }
+        ys_.shrink_to_fit();
+        data_.assign(ys_.size(), 0);
+        points_.clear();
+        points_.shrink_to_fit();
+    }
+
+    void clear() {
+        data_.assign(data_.size(), 0);
+    }
+
+    size_type nodes_count() const {
+        return ys_.size();
+    }
+
+    bool inc(const coordinate_type x, const coordinate_type y, const value_type delta)
+    // returns false and changes nothing if the update can not be stored exactly: x is not a registered x or y
+    // is missing from the first outer node on the path. That node also holds y of other points with nearby x,
+    // so an unregistered {x, y} may be accepted; the update is still exact then, as the following outer nodes
+    // cover growing x ranges and hold y as well
+    {
+        const size_type first = x_index(x);
+        if (first == xs_.size() || xs_[first] != x
+                || !std::binary_search(ys_.cbegin() + offsets_[first], ys_.cbegin() + offsets_[first + 1], y)) {
+            return false;
+        }
+        for (size_type v = first; v < xs_.size(); v = (v | (v + 1))) {
+            const size_type begin = offsets_[v];
+            const size_type size = offsets_[v + 1] - begin;
+            const size_type position = std::lower_bound(ys_.cbegin() + begin, ys_.cbegin() + begin + size, y) - ys_.cbegin() - begin;
+            value_type* row = data_.data() + begin;
+            for (size_type u = position; u < size; u = (u | (u + 1))) {
+                row[u] += delta;
+            }
+        }
+        return true;
+    }
+
+    value_type query(const coordinate_type x, const coordinate_type y) const
+    // returns sum for points with coordinates not greater than {x, y}
+    {
+        return prefix(std::upper_bound(xs_.cbegin(), xs_.cend(), x) - xs_.cbegin(), y, true);
+    }
+
+    value_type query(const coordinate_type x1, const coordinate_type y1, const coordinate_type x2, const coordinate_type y2) const
+    // returns sum for range {x1, y1}..{x2, y2}
+    {
+        if (x1 > x2 || y1 > y2) {
+            return 0;
+        }
+        const size_type x_less = std::lower_bound(xs_.cbegin(), xs_.cend(), x1) - xs_.cbegin();
+        const size_type x_not_greater = std::upper_bound(xs_.cbegin(), xs_.cend(), x2) - xs_.cbegin();
+        return prefix(x_not_greater, y2, true) + prefix(x_less, y1, false)
+            - prefix(x_not_greater, y1, false) - prefix(x_less, y2, true);
+    }
+
+private:
+    std::vector<std::pair<coordinate_type, coordinate_type>> points_;
+    std::vector<coordinate_type> xs_;
+    // y of outer node v are ys_[offsets_[v]..offsets_[v + 1]), data_ holds their inner trees at the same positions
+    std::vector<size_type> offsets_;
+    std::vector<coordinate_type> ys_;
+    std::vector<value_type> data_;
+
+    size_type x_index(const coordinate_type x) const {
+        return std::lower_bound(xs_.cbegin(), xs_.cend(), x) - xs_.cbegin();
+    }
+
+    value_type prefix(const size_type x_count, const coordinate_type y, const bool y_inclusive) const
+    // sum over the first x_count distinct x and y not greater than (less than if !y_inclusive) the given one
+    {
+        value_type res = 0;
+        for (int64_t v = static_cast<int64_t>(x_count) - 1; v >= 0; v = (v & (v + 1)) - 1) {
+            const auto first = ys_.cbegin() + offsets_[v];
+            const auto last = ys_.cbegin() + offsets_[v + 1];
+            const int64_t count = (y_inclusive ? std::upper_bound(first, last, y) : std::lower_bound(first, last, y)) - first;
+            const value_type* row = data_.data() + offsets_[v];
+            for (int64_t u = count - 1; u >= 0; u = (u & (u + 1)) - 1) {
+                res += row[u];
+            }
+        }
+        return res;
+    }
+};
@@ -0,0 +1,388 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "maths/bits.hpp"
+#include "suffix_array.hpp"
+
+class FMIndex {
+// compressed full-text index of a byte string: the BWT of text + sentinel in a wavelet matrix over the used symbols,
+// the SA values of rows whose text position is a multiple of sample_rate and a bitvector marking those rows.
+// count() is backward search with O(bit_width(alphabet)) ranks per pattern char, so O(m) for a fixed alphabet;
+// locate() walks LF at most sample_rate - 1 times from a row to a sampled one.
+// Everything lives in one flat array of 64-bit words (header, symbol codes, per-symbol offsets, bitvector levels,
+// marks, samples) which is saved as is and can be used in place with attach(), e.g. from mmap. The byte order is native.
+// Bitvectors are blocks of 9 words: ones before the block, then 512 bits. SA row ranges are half-open
+public:
+    using size_type = std::size_t;
+    using word_type = uint64_t;
+    using interval_type = std::pair<size_type, size_type>;
+
+    static constexpr word_type kMagic = 0x31584544494D4621ULL;
+    static constexpr size_type kHeaderSize = 8;
+    static constexpr size_type kSymbolsCount = 256;
+    static constexpr size_type kBlockWordsPower = 3;
+    static constexpr size_type kBlockWords = (1 << kBlockWordsPower) + 1;
+    static constexpr size_type kBlockBitsPower = kBlockWordsPower + 6;
+    // bound on the rows of a loaded header, so the layout sizes cannot overflow
+    static constexpr size_type kMaxRows = static_cast<size_type>(1) << 48;
+
+    FMIndex() = default;
+
+    FMIndex(const char* s, const size_type n, const size_type sample_rate = 32) {
+        build(s, n, sample_rate);
+    }
+
+    explicit FMIndex(const std::string& s, const size_type sample_rate = 32) :
+            FMIndex(s.data(), s.length(), sample_rate)
+    {}
+
+    bool build(const char* s, const size_type n, const size_type sample_rate = 32)
+    // returns false and changes nothing if sample_rate is 0 or the text is longer than SuffixArraySais::kMaxLength,
+    // the limit of its 32-bit indices
+    {
+        if (sample_rate == 0 || n > SuffixArraySais::kMaxLength) {
+            return false;
+        }
+        const unsigned char* text = reinterpret_cast<const unsigned char*>(s);
+        std::vector<word_type> codes(kSymbolsCount, 0);
+        for (size_type i = 0; i < n; ++i) {
+            codes[text[i]] = 1;
+        }
+        size_type alphabet = 1;
+        for (word_type& code : codes) {
+            if (code != 0) {
+                code = alphabet++;
+            }
+        }
+
+        const size_type rows = n + 1;
+        const size_type bits_count = std::max<size_type>(bit_width(alphabet - 1), 1);
+        std::vector<SuffixArraySais::index_type> sa(n);
+        SuffixArraySais().build(text, static_cast<SuffixArraySais::index_type>(n), kSymbolsCount, sa.data());
+        // row 0 is the sentinel suffix, row i + 1 is sa[i]
+        const auto row_position = [&](const size_type row) -> size_type {
+            return row == 0 ? n : static_cast<size_type>(sa[row - 1]);
+        };
+        size_type samples_count = 0;
+        for (size_type row = 0; row < rows; ++row) {
+            if (row_position(row) % sample_rate == 0) {
+                ++samples_count;
+            }
+        }
+
+        external_ = nullptr;
+        buffer_.assign(kHeaderSize, 0);
+        buffer_[0] = kMagic;
+        buffer_[2] = rows;
+        buffer_[3] = alphabet;
+        buffer_[4] = bits_count;
+        buffer_[5] = sample_rate;
+        buffer_[6] = samples_count;
+        init_layout(buffer_.data());
+        buffer_[1] = total_words_;
+        buffer_.resize(total_words_, 0);
+        word_type* data = buffer_.data();
+        std::copy(codes.cbegin(), codes.cend(), data + codes_);
+
+        word_type* marks = data + marks_;
+        word_type* samples = data + samples_;
+        for (size_type row = 0, sample = 0; row < rows; ++row) {
+            const size_type position = row_position(row);
+            if (position % sample_rate == 0) {
+                set_bit(marks, row);
+                samples[sample++] = position;
+            }
+        }
+        build_ranks(marks);
+
+        std::vector<uint16_t> bwt(rows);
+        std::vector<size_type> counts(alphabet + 1, 0);
+        for (size_type row = 0; row < rows; ++row) {
+            const size_type position = row_position(row);
+            bwt[row] = static_cast<uint16_t>(position == 0 ? 0 : codes[text[position - 1]]);
+            ++counts[bwt[row] + 1];
+        }
+        sa.clear();
+        sa.shrink_to_fit();
+        for (size_type c = 0; c < alphabet; ++c) {
+            counts[c + 1] += counts[c];
+        }
+
+        std::vector<uint16_t> ones;
+        for (size_type level = 0; level < bits_count; ++level) {
+            const size_type bit = bits_count - 1 - level;
+            word_type* bits = data + level_offset(level);
+            ones.clear();
+            size_type zeros = 0;
+            for (size_type i = 0; i < rows; ++i) {
+                if (((bwt[i] >> bit) & 1) != 0) {
+                    set_bit(bits, i);
+                    ones.emplace_back(bwt[i]);
+                } else {
+                    bwt[zeros++] = bwt[i];
+                }
+            }
+            build_ranks(bits);
+            data[zeros_ + level] = zeros;
+            std::copy(ones.cbegin(), ones.cend(), bwt.begin() + zeros);
+        }
+        bwt.clear();
+        bwt.shrink_to_fit();
+
+        for (size_type c = 0; c < alphabet; ++c) {
+            size_type left = 0;
+            size_type right = 0;
+            descend(c, &left, &right);
+            data[offsets_ + c] = counts[c] - left;
+        }
+        return true;
+    }
+
+    bool save(std::FILE* file) const {
+        return total_words_ == 0 || std::fwrite(base(), sizeof(word_type), total_words_, file) == total_words_;
+    }
+
+    bool load(std::FILE* file)
+    // reads a saved index into the owned memory; on failure the index is left empty
+    {
+        std::vector<word_type> buffer(kHeaderSize);
+        if (std::fread(buffer.data(), sizeof(word_type), kHeaderSize, file) != kHeaderSize
+                || buffer[0] != kMagic || !init_layout(buffer.data()) || total_words_ != buffer[1]) {
+            clear();
+            return false;
+        }
+        buffer.resize(total_words_);
+        const size_type rest = total_words_ - kHeaderSize;
+        if (std::fread(buffer.data() + kHeaderSize, sizeof(word_type), rest, file) != rest || !valid_codes(buffer.data())) {
+            clear();
+            return false;
+        }
+        buffer_.swap(buffer);
+        external_ = nullptr;
+        return true;
+    }
+
+    bool attach(const word_type* data, const size_type words_count)
+    // uses a saved index in place without copying, the memory should outlive the index.
+    // On failure the index is left empty
+    {
+        if (words_count < kHeaderSize || data[0] != kMagic || data[1] != words_count
+                || !init_layout(data) || total_words_ != words_count || !valid_codes(data)) {
+            clear();
+            return false;
+        }
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        external_ = data;
+        return true;
+    }
+
+    const word_type* data() const {
+        return base();
+    }
+
+    size_type words_count() const {
+        return total_words_;
+    }
+
+    size_type size() const
+    // text length
+    {
+        return rows_ - 1;
+    }
+
+    interval_type find(const char* pattern, const size_type m) const
+    // rows of the suffixes starting with the pattern, empty if there are none. Row 0 is the empty suffix,
+    // it is not counted for the empty pattern either, so count("") is size() as in EnhancedSuffixArray
+    {
+        if (total_words_ == 0 || rows_ == 1) {
+            return interval_type(0, 0);
+        }
+        if (m == 0) {
+            return interval_type(1, rows_);
+        }
+        const word_type* data = base();
+        size_type left = 0;
+        size_type right = rows_;
+        for (size_type i = m; i-- > 0 && left < right; ) {
+            const word_type code = data[codes_ + static_cast<unsigned char>(pattern[i])];
+            if (code == 0) {
+                return interval_type(0, 0);
+            }
+            descend(code, &left, &right);
+            left += data[offsets_ + code];
+            right += data[offsets_ + code];
+        }
+        return left < right ? interval_type(left, right) : interval_type(0, 0);
+    }
+
+    interval_type find(const std::string& pattern) const {
+        return find(pattern.data(), pattern.length());
+    }
+
+    size_type count(const std::string& pattern) const {
+        const interval_type interval = find(pattern);
+        return interval.second - interval.first;
+    }
+
+    size_type locate(size_type row) const
+    // text position of the suffix in the given row
+    {
+        const word_type* data = base();
+        size_type steps = 0;
+        while (!get_bit(data + marks_, row)) {
+            row = lf(row);
+            ++steps;
+        }
+        return data[samples_ + rank1(data + marks_, row)] + steps;
+    }
+
+    std::vector<size_type> locate(const std::string& pattern) const
+    // text positions of all occurrences in SA order
+    {
+        const interval_type interval = find(pattern);
+        std::vector<size_type> positions;
+        positions.reserve(interval.second - interval.first);
+        for (size_type row = interval.first; row < interval.second; ++row) {
+            positions.emplace_back(locate(row));
+        }
+        return positions;
+    }
+
+private:
+    std::vector<word_type> buffer_;
+    const word_type* external_ = nullptr;
+    // layout decoded from the header, word offsets into the data
+    size_type rows_ = 1;
+    size_type alphabet_ = 0;
+    size_type bits_count_ = 0;
+    size_type bitvector_words_ = 0;
+    size_type codes_ = 0;
+    size_type offsets_ = 0;
+    size_type zeros_ = 0;
+    size_type levels_ = 0;
+    size_type marks_ = 0;
+    size_type samples_ = 0;
+    size_type total_words_ = 0;
+
+    const word_type* base() const {
+        return external_ != nullptr ? external_ : buffer_.data();
+    }
+
+    void clear() {
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        external_ = nullptr;
+        rows_ = 1;
+        total_words_ = 0;
+    }
+
+    bool init_layout(const word_type* header) {
+        rows_ = header[2];
+        alphabet_ = header[3];
+        bits_count_ = header[4];
+        if (rows_ == 0 || rows_ > kMaxRows || alphabet_ == 0 || alphabet_ > kSymbolsCount + 1
+                || bits_count_ != std::max<size_type>(bit_width(alphabet_ - 1), 1) || header[5] == 0 || header[6] > rows_) {
+            total_words_ = 0;
+            return false;
+        }
+        bitvector_words_ = ((rows_ >> kBlockBitsPower) + 1) * kBlockWords;
+        codes_ = kHeaderSize;
+        offsets_ = codes_ + kSymbolsCount;
+        zeros_ = offsets_ + alphabet_;
+        levels_ = zeros_ + bits_count_;
+        marks_ = levels_ + bits_count_ * bitvector_words_;
+        samples_ = marks_ + bitvector_words_;
+        total_words_ = samples_ + header[6];
+        return true;
+    }
+
+    bool valid_codes(const word_type* data) const
+    // symbol codes index the per-symbol offsets, so they should be below alphabet_
+    {
+        return std::all_of(data + codes_, data + codes_ + kSymbolsCount, [&](const word_type code) {
+            return code < alphabet_;
+        });
+    }
+
+    size_type level_offset(const size_type level) const {
+        return levels_ + level * bitvector_words_;
+    }
+
+    static void set_bit(word_type* bits, const size_type index) {
+        bits[(index >> kBlockBitsPower) * kBlockWords + 1 + ((index >> 6) & ((1 << kBlockWordsPower) - 1))] |=
+                static_cast<word_type>(1) << (index & 63);
+    }
+
+    static bool get_bit(const word_type* bits, const size_type index) {
+        return ((bits[(index >> kBlockBitsPower) * kBlockWords + 1 + ((index >> 6) & ((1 << kBlockWordsPower) - 1))]
+                >> (index & 63)) & 1) != 0;
+    }
+
+    static size_type rank1(const word_type* bits, const size_type index)
+    // ones in [0, index)
+    {
+        const word_type* block = bits + (index >> kBlockBitsPower) * kBlockWords;
+        const size_type word = (index >> 6) & ((1 << kBlockWordsPower) - 1);
+        size_type result = block[0];
+        for (size_type i = 1; i <= word; ++i) {
+            result += popcount(block[i]);
+        }
+        if ((index & 63) != 0) {
+            result += popcount(block[word + 1] << (64 - (index & 63)));
+        }
+        return result;
+    }
+
+    void build_ranks(word_type* bits) const {
+        word_type ones = 0;
+        for (size_type block = 0; block < bitvector_words_; block += kBlockWords) {
+            bits[block] = ones;
+            for (size_type i = 1; i < kBlockWords; ++i) {
+                ones += popcount(bits[block + i]);
+            }
+        }
+    }
+
+    void descend(const word_type code, size_type* left, size_type* right) const
+    // maps [left, right) of level 0 to the positions of its occurrences of code on the last level
+    {
+        const word_type* data = base();
+        for (size_type level = 0; level < bits_count_; ++level) {
+            const word_type* bits = data + level_offset(level);
+            const size_type ones_left = rank1(bits, *left);
+            const size_type ones_right = rank1(bits, *right);
+            if (((code >> (bits_count_ - 1 - level)) & 1) != 0) {
+                *left = data[zeros_ + level] + ones_left;
+                *right = data[zeros_ + level] + ones_right;
+            } else {
+                *left -= ones_left;
+                *right -= ones_right;
+            }
+        }
+    }
+
+    size_type lf(size_type row) const
+    // row of the suffix one position to the left; the BWT symbol is decoded on the way
+    {
+        const word_type* data = base();
+        word_type code = 0;
+        for (size_type level = 0; level < bits_count_; ++level) {
+            const word_type* bits = data + level_offset(level);
+            const size_type ones = rank1(bits, row);
+            code <<= 1;
+            if (get_bit(bits, row)) {
+                code |= 1;
+                row = data[zeros_ + level] + ones;
+            } else {
+                row -= ones;
+            }
+        }
+        return data[offsets_ + code] + row;
+    }
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "maths/bits.hpp"
+
+template<typename T, typename Cmp = std::less<T>>
+class LinearRmqCmp {
+// O(n) memory, O(1) query replacement of SparseTableCmp. The array is split into blocks of 64 elements:
+// masks_[i] is the monotone stack of positions of the block of i built up to i, so the answer inside a block
+// is the lowest set bit of the mask at the right border above the left one, and a sparse table over the
+// block answers covers the whole blocks between. The data is owned. Ties resolve to the leftmost position
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using comparator_type = Cmp;
+    using container_type = std::vector<value_type>;
+    using mask_type = uint64_t;
+
+    static constexpr size_type kBlockSize = 64;
+    static constexpr size_type kBlockPower = 6;
+
+    explicit LinearRmqCmp(container_type data, const comparator_type& cmp = comparator_type()) :
+            data_(std::move(data)),
+            cmp_(cmp),
+            blocks_count_((data_.size() + kBlockSize - 1) >> kBlockPower),
+            masks_(data_.size())
+    {
+        build_masks();
+        build_table();
+    }
+
+    size_type size() const {
+        return data_.size();
+    }
+
+    const container_type& data() const {
+        return data_;
+    }
+
+    size_type query(const size_type left, const size_type right) const
+    // query for range [left, right)
+    {
+        const size_type last = right - 1;
+        const size_type left_block = left >> kBlockPower;
+        const size_type right_block = last >> kBlockPower;
+        if (left_block == right_block) {
+            return in_block(left, last);
+        }
+        size_type result = in_block(left, (left_block << kBlockPower) + kBlockSize - 1);
+        if (left_block + 1 < right_block) {
+            const size_type from = left_block + 1;
+            const size_type level = bit_width(right_block - from) - 1;
+            result = better(result, table_[level * blocks_count_ + from]);
+            result = better(result, table_[level * blocks_count_ + right_block - (static_cast<size_type>(1) << level)]);
+        }
+        return better(result, in_block(right_block << kBlockPower, last));
+    }
+
+private:
+    container_type data_;
+    comparator_type cmp_;
+    size_type blocks_count_;
+    std::vector<mask_type> masks_;
+    // level k holds the answers for 2^k blocks starting at every block, levels are stored one after another
+    std::vector<size_type> table_;
+
+    size_type better(const size_type x, const size_type y) const
+    // x should be to the left of y
+    {
+        return cmp_(data_[y], data_[x]) ? y : x;
+    }
+
+    size_type in_block(const size_type left, const size_type right) const {
+        const size_type begin = (left >> kBlockPower) << kBlockPower;
+        return begin + countr_zero(masks_[right] & (~static_cast<mask_type>(0) << (left - begin)));
+    }
+
+    void build_masks() {
+        for (size_type begin = 0; begin < data_.size(); begin += kBlockSize) {
+            mask_type stack = 0;
+            for (size_type i = begin; i < data_.size() && i < begin + kBlockSize; ++i) {
+                while (stack != 0) {
+                    const size_type top = begin + kBlockSize - 1 - countl_zero(stack);
+                    if (!cmp_(data_[i], data_[top])) {
+                        break;
+                    }
+                    stack ^= static_cast<mask_type>(1) << (top - begin);
+                }
+                stack |= static_cast<mask_type>(1) << (i - begin);
+                masks_[i] = stack;
+            }
+        }
+    }
+
+    void build_table() {
+        if (blocks_count_ == 0) {
+            return;
+        }
+        const size_type levels = bit_width(blocks_count_);
+        table_.resize(levels * blocks_count_);
+        for (size_type block = 0; block < blocks_count_; ++block) {
+            const size_type begin = block << kBlockPower;
+            table_[block] = in_block(begin, std::min(begin + kBlockSize, data_.size()) - 1);
+        }
+        for (size_type level = 1; level < levels; ++level) {
+            const size_type half = static_cast<size_type>(1) << (level - 1);
+            const size_type* previous = table_.data() + (level - 1) * blocks_count_;
+            size_type* current = table_.data() + level * blocks_count_;
+            for (size_type block = 0; block + 2 * half <= blocks_count_; ++block) {
+                current[block] = better(previous[block], previous[block + half]);
+            }
+        }
+    }
+};
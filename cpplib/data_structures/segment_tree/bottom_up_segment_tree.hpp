@@ -1,81 +1,148 @@
 #pragma once
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <vector>
 
+#include "base_segment_tree.hpp"
 #include "maths/bits.hpp"
 
-template<typename T>
-class BottomUpSegmentTree {
+template<typename T, typename Merge = std::function<T(const T&, const T&)>>
+class BottomUpSegmentTree : public BaseSegmentTree<T, Merge> {
+// merge is called directly, so it can be inlined; the default std::function merge is kept as a type-erased adapter
 public:
-    using functor_type = std::function<T(const T&, const T&)>;
+    using merge_type = Merge;
+    using value_type = T;
+    using functor_type = merge_type;
 
-    BottomUpSegmentTree(const size_t N, const functor_type& pred, const T& neutral_ = T(0)) :
-            pred_(pred),
-            N_(N),
-            neutral_(neutral_) {
-        offset_ = bit_ceil(N);
-        size_ = offset_ << 1;
-        data_.resize(size_);
-        init();
-    }
+    using Base = BaseSegmentTree<value_type, merge_type>;
+    using size_type = typename Base::size_type;
+
+    BottomUpSegmentTree(const size_type N, const merge_type& merge, const value_type& neutral = value_type(0)) :
+            Base(N, neutral, merge)
+    {}
 
-    constexpr size_t offset() const {
-        return offset_;
+    template<typename Iterator>
+    BottomUpSegmentTree(Iterator first, Iterator last, const merge_type& merge, const value_type& neutral = value_type(0)) :
+            Base(std::distance(first, last), neutral, merge)
+    {
+        build(first, last);
     }
 
-    constexpr size_t size() const {
-        return size_;
+    constexpr value_type neutral() const {
+        return default_value_;
     }
 
-    constexpr size_t elements_count() const {
-        return N_;
+    void init() {
+        std::fill(data_.begin(), data_.end(), default_value_);
     }
 
-    constexpr T neutral() const {
-        return neutral_;
+    using Base::build;
+
+    template<typename Iterator>
+    void build(Iterator first, Iterator last)
+    // O(n), elements after the given ones are set to neutral
+    {
+        const auto leaves = data_.begin() + offset_;
+        std::fill(std::copy(first, last, leaves), data_.end(), default_value_);
+        for (size_type i = offset_ - 1; i >= 1; --i) {
+            this->merge_children(i);
+        }
     }
 
-    std::vector<T>& data() const {
-        return data_;
+    value_type query(const size_type left, const size_type right) const
+    // inclusive range, the order of elements is kept, so merge is not required to be commutative
+    {
+        value_type left_result = default_value_;
+        value_type right_result = default_value_;
+        for (size_type l = left + offset_, r = right + offset_ + 1; l < r; l >>= 1, r >>= 1) {
+            if ((l & 1) != 0) {
+                left_result = merge_(left_result, data_[l++]);
+            }
+            if ((r & 1) != 0) {
+                right_result = merge_(data_[--r], right_result);
+            }
+        }
+        return merge_(left_result, right_result);
     }
 
-    void init() {
-        std::fill_n(data_.begin(), data_.size(), neutral_);
+    value_type get(const size_type position) const {
+        return data_[position + offset_];
     }
 
-    void build(T a[]) {
-        std::copy(a, a + N_, data_.begin() + offset_);
-        for (size_t i = offset_ - 1; i >= 1; --i) {
-            data_[i] = pred_(data_[i << 1], data_[(i << 1) ^ 1]);
+    void update(const size_type position, const value_type& value) {
+        size_type pos = position + offset_;
+        data_[pos] = value;
+        for (pos >>= 1; pos >= 1; pos >>= 1) {
+            this->merge_children(pos);
         }
     }
 
-    T query(const size_t left, const size_t right) const {
-        T res = neutral_;
-        for (size_t l = left + offset_, r = right + offset_; l <= r; l >>= 1, r >>= 1) {
-            if (l & 1) {
-                res = pred_(data_[l++], res);
+    template<typename Predicate>
+    size_type max_right(const size_type left, Predicate pred) const
+    // the maximal right such that pred(merge of [left, right)) is true, pred(neutral) has to be true
+    // and pred has to be monotone: once false for some right it stays false for all larger ones
+    {
+        if (left == elements_count_) {
+            return elements_count_;
+        }
+        size_type v = left + offset_;
+        value_type acc = default_value_;
+        do {
+            while ((v & 1) == 0) {
+                v >>= 1;
             }
-            if ((r & 1) == 0) {
-                res = pred_(data_[r--], res);
+            if (!pred(merge_(acc, data_[v]))) {
+                while (v < offset_) {
+                    v <<= 1;
+                    const value_type next = merge_(acc, data_[v]);
+                    if (pred(next)) {
+                        acc = next;
+                        ++v;
+                    }
+                }
+                return v - offset_;
             }
-        }
-        return res;
+            acc = merge_(acc, data_[v]);
+            ++v;
+        } while ((v & (~v + 1)) != v);
+        return elements_count_;
     }
 
-    void update(const size_t position, const T& value) {
-        size_t pos = position + offset_;
-        data_[pos] = value;
-        for (pos >>= 1; pos >= 1; pos >>= 1) {
-            data_[pos] = pred_(data_[pos << 1], data_[(pos << 1) ^ 1]);
+    template<typename Predicate>
+    size_type min_left(const size_type right, Predicate pred) const
+    // the minimal left such that pred(merge of [left, right)) is true, with the same requirements as in max_right
+    {
+        if (right == 0) {
+            return 0;
         }
+        size_type v = right + offset_;
+        value_type acc = default_value_;
+        do {
+            --v;
+            while (v > 1 && (v & 1) != 0) {
+                v >>= 1;
+            }
+            if (!pred(merge_(data_[v], acc))) {
+                while (v < offset_) {
+                    v = (v << 1) ^ 1;
+                    const value_type next = merge_(data_[v], acc);
+                    if (pred(next)) {
+                        acc = next;
+                        --v;
+                    }
+                }
+                return v + 1 - offset_;
+            }
+            acc = merge_(data_[v], acc);
+        } while ((v & (~v + 1)) != v);
+        return 0;
     }
 
-private:
-    std::vector<T> data_;
-    const functor_type pred_;
-    const T neutral_;
-    size_t offset_;
-    size_t size_;
-    size_t N_;
+protected:
+    using Base::elements_count_;
+    using Base::offset_;
+    using Base::data_;
+    using Base::merge_;
+    using Base::default_value_;
 };
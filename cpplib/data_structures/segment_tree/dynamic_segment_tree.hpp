@@ -0,0 +1,273 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template<typename T, typename Merge, typename Update, typename ApplyUpdate, typename MergeUpdates>
+class DynamicSegmentTree {
+// lazy segment tree over [0, coordinates_limit) with nodes created on demand, O(log U) new nodes per operation.
+// Nodes live in one pool and refer to children by 32-bit indices, index 0 is a shared node for untouched segments,
+// so every untouched element holds default_value (which has to be neutral for merge).
+// Functors have the same signatures as in TopDownSegmentTree and LazySegmentTree, ranges are inclusive
+public:
+    using apply_update_type = ApplyUpdate;
+    using merge_type = Merge;
+    using merge_updates_type = MergeUpdates;
+    using update_type = Update;
+    using value_type = T;
+
+    using size_type = std::size_t;
+    using coordinate_type = uint64_t;
+    using node_id_type = uint32_t;
+
+    static constexpr coordinate_type kMaxCoordinatesLimit = static_cast<coordinate_type>(1) << 63;
+
+    explicit DynamicSegmentTree(
+            const coordinate_type coordinates_limit = kMaxCoordinatesLimit,
+            const value_type& default_value = value_type(0),
+            const merge_type& merge = merge_type(),
+            const update_type& default_update = update_type(),
+            const apply_update_type& apply_update = apply_update_type(),
+            const merge_updates_type& merge_updates = merge_updates_type()
+    ) :
+            last_coordinate_(coordinates_limit - 1),
+            default_value_(default_value),
+            merge_(merge),
+            default_update_(default_update),
+            apply_update_(apply_update),
+            merge_updates_(merge_updates)
+    {
+        reset();
+    }
+
+    void reserve(const size_type nodes_count) {
+        nodes_.reserve(nodes_count);
+    }
+
+    void reset()
+    // all elements become default_value, the memory of the pool is kept
+    {
+        nodes_.clear();
+        nodes_.emplace_back(Node{default_value_, default_update_, 0, 0, false});
+        root_ = 0;
+    }
+
+    size_type nodes_count() const {
+        return nodes_.size();
+    }
+
+    void range_update(const coordinate_type left, const coordinate_type right, const update_type& update) {
+        root_ = update_impl(root_, 0, last_coordinate_, left, right, update);
+    }
+
+    void point_update(const coordinate_type index, const update_type& update) {
+        range_update(index, index, update);
+    }
+
+    void set(const coordinate_type index, const value_type& value) {
+        root_ = set_impl(root_, 0, last_coordinate_, index, value);
+    }
+
+    void erase(const coordinate_type left, const coordinate_type right)
+    // resets the elements to default_value; fully covered subtrees are detached, compact() reclaims them
+    {
+        root_ = erase_impl(root_, 0, last_coordinate_, left, right);
+    }
+
+    value_type get(const coordinate_type index) {
+        return get(index, index);
+    }
+
+    value_type get(const coordinate_type left, const coordinate_type right) {
+        return get_impl(root_, 0, last_coordinate_, left, right);
+    }
+
+    value_type get_all() const {
+        return nodes_[root_].value;
+    }
+
+    void compact()
+    // moves the nodes reachable from the root to a new pool in preorder, dropping detached ones
+    {
+        std::vector<Node> nodes;
+        nodes.reserve(nodes_.size());
+        nodes.emplace_back(nodes_[0]);
+        if (root_ != 0) {
+            // (old id, link) pairs, link is twice the new id of the parent plus 1 for a right child, 0 for the root
+            std::vector<std::pair<node_id_type, uint64_t>> stack;
+            stack.emplace_back(root_, 0);
+            while (!stack.empty()) {
+                const node_id_type old_id = stack.back().first;
+                const uint64_t link = stack.back().second;
+                stack.pop_back();
+                const node_id_type new_id = static_cast<node_id_type>(nodes.size());
+                nodes.emplace_back(nodes_[old_id]);
+                if (link != 0) {
+                    if ((link & 1) == 0) {
+                        nodes[link >> 1].left = new_id;
+                    } else {
+                        nodes[link >> 1].right = new_id;
+                    }
+                }
+                if (nodes_[old_id].right != 0) {
+                    stack.emplace_back(nodes_[old_id].right, (static_cast<uint64_t>(new_id) << 1) | 1);
+                }
+                if (nodes_[old_id].left != 0) {
+                    stack.emplace_back(nodes_[old_id].left, static_cast<uint64_t>(new_id) << 1);
+                }
+            }
+            root_ = 1;
+        }
+        nodes.shrink_to_fit();
+        nodes_.swap(nodes);
+    }
+
+private:
+    struct Node {
+        value_type value;
+        update_type update;
+        node_id_type left;
+        node_id_type right;
+        bool has_update;
+    };
+
+    coordinate_type last_coordinate_;
+    const value_type default_value_;
+    const merge_type merge_;
+    const update_type default_update_;
+    const apply_update_type apply_update_;
+    const merge_updates_type merge_updates_;
+    std::vector<Node> nodes_;
+    node_id_type root_;
+
+    static constexpr coordinate_type get_mid(const coordinate_type cur_left, const coordinate_type cur_right) {
+        return cur_left + (cur_right - cur_left) / 2;
+    }
+
+    node_id_type create() {
+        nodes_.emplace_back(Node{default_value_, default_update_, 0, 0, false});
+        return static_cast<node_id_type>(nodes_.size() - 1);
+    }
+
+    void apply_node(const node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right, const update_type& update) {
+        Node& node = nodes_[v];
+        node.value = apply_update_(node.value, update, cur_left, cur_right);
+        if (cur_left != cur_right) {
+            node.update = merge_updates_(node.update, update);
+            node.has_update = true;
+        }
+    }
+
+    void push(const node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right) {
+        if (!nodes_[v].has_update) {
+            return;
+        }
+        if (nodes_[v].left == 0) {
+            const node_id_type child = create();
+            nodes_[v].left = child;
+        }
+        if (nodes_[v].right == 0) {
+            const node_id_type child = create();
+            nodes_[v].right = child;
+        }
+        const coordinate_type mid = get_mid(cur_left, cur_right);
+        const update_type update = nodes_[v].update;
+        apply_node(nodes_[v].left, cur_left, mid, update);
+        apply_node(nodes_[v].right, mid + 1, cur_right, update);
+        nodes_[v].update = default_update_;
+        nodes_[v].has_update = false;
+    }
+
+    void pull(const node_id_type v) {
+        nodes_[v].value = merge_(nodes_[nodes_[v].left].value, nodes_[nodes_[v].right].value);
+    }
+
+    node_id_type update_impl(node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right,
+                             const coordinate_type left, const coordinate_type right, const update_type& update) {
+        if (v == 0) {
+            v = create();
+        }
+        if (left <= cur_left && cur_right <= right) {
+            apply_node(v, cur_left, cur_right, update);
+            return v;
+        }
+        push(v, cur_left, cur_right);
+        const coordinate_type mid = get_mid(cur_left, cur_right);
+        if (left <= mid) {
+            const node_id_type child = update_impl(nodes_[v].left, cur_left, mid, left, right, update);
+            nodes_[v].left = child;
+        }
+        if (right > mid) {
+            const node_id_type child = update_impl(nodes_[v].right, mid + 1, cur_right, left, right, update);
+            nodes_[v].right = child;
+        }
+        pull(v);
+        return v;
+    }
+
+    node_id_type set_impl(node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right,
+                          const coordinate_type index, const value_type& value) {
+        if (v == 0) {
+            v = create();
+        }
+        if (cur_left == cur_right) {
+            nodes_[v].value = value;
+            return v;
+        }
+        push(v, cur_left, cur_right);
+        const coordinate_type mid = get_mid(cur_left, cur_right);
+        if (index <= mid) {
+            const node_id_type child = set_impl(nodes_[v].left, cur_left, mid, index, value);
+            nodes_[v].left = child;
+        } else {
+            const node_id_type child = set_impl(nodes_[v].right, mid + 1, cur_right, index, value);
+            nodes_[v].right = child;
+        }
+        pull(v);
+        return v;
+    }
+
+    node_id_type erase_impl(const node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right,
+                            const coordinate_type left, const coordinate_type right) {
+        if (v == 0 || (left <= cur_left && cur_right <= right)) {
+            return 0;
+        }
+        push(v, cur_left, cur_right);
+        const coordinate_type mid = get_mid(cur_left, cur_right);
+        if (left <= mid) {
+            const node_id_type child = erase_impl(nodes_[v].left, cur_left, mid, left, right);
+            nodes_[v].left = child;
+        }
+        if (right > mid) {
+            const node_id_type child = erase_impl(nodes_[v].right, mid + 1, cur_right, left, right);
+            nodes_[v].right = child;
+        }
+        if (nodes_[v].left == 0 && nodes_[v].right == 0) {
+            return 0;
+        }
+        pull(v);
+        return v;
+    }
+
+    value_type get_impl(const node_id_type v, const coordinate_type cur_left, const coordinate_type cur_right,
+                        const coordinate_type left, const coordinate_type right) {
+        if (v == 0) {
+            return default_value_;
+        }
+        if (left <= cur_left && cur_right <= right) {
+            return nodes_[v].value;
+        }
+        push(v, cur_left, cur_right);
+        const coordinate_type mid = get_mid(cur_left, cur_right);
+        if (right <= mid) {
+            return get_impl(nodes_[v].left, cur_left, mid, left, right);
+        }
+        if (left > mid) {
+            return get_impl(nodes_[v].right, mid + 1, cur_right, left, right);
+        }
+        return merge_(
+                get_impl(nodes_[v].left, cur_left, mid, left, right),
+                get_impl(nodes_[v].right, mid + 1, cur_right, left, right)
+        );
+    }
+};
@@ -0,0 +1,307 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+#include "base_segment_tree.hpp"
+#include "maths/bits.hpp"
+
+template<typename T, typename Merge, typename Update, typename ApplyUpdate, typename MergeUpdates>
+class LazySegmentTree : public BaseSegmentTree<T, Merge> {
+// iterative lazy propagation: updates are pushed down only along the two boundary paths of a range,
+// the canonical nodes between them are tagged and the boundary paths are recomputed bottom-up.
+// Queries are const: pending updates of the boundary paths are folded into the result instead of being pushed.
+// Functors have the same signatures as in TopDownSegmentTree, apply_update(value, update, left, right)
+// gets the segment covered by the value, which in queries is not always a node; default_update has to be the identity update.
+// Ranges are inclusive
+public:
+    using apply_update_type = ApplyUpdate;
+    using merge_type = Merge;
+    using merge_updates_type = MergeUpdates;
+    using update_type = Update;
+    using value_type = T;
+
+    using Base = BaseSegmentTree<value_type, merge_type>;
+    using size_type = typename Base::size_type;
+
+    struct Operation {
+    // a range update or, if is_query is set, a range query; update is ignored for queries
+        size_type left;
+        size_type right;
+        bool is_query;
+        update_type update;
+    };
+
+    explicit LazySegmentTree(
+            const size_type elements_count,
+            const value_type& default_value = value_type(0),
+            const merge_type& merge = merge_type(),
+            const update_type& default_update = update_type(),
+            const apply_update_type& apply_update = apply_update_type(),
+            const merge_updates_type& merge_updates = merge_updates_type()
+    ) :
+            Base(elements_count, default_value, merge),
+            height_(countr_zero(offset_)),
+            updates_(offset_, default_update),
+            has_update_(offset_, false),
+            default_update_(default_update),
+            apply_update_(apply_update),
+            merge_updates_(merge_updates)
+    {}
+
+    void build(const value_type* a) override {
+        std::fill(updates_.begin(), updates_.end(), default_update_);
+        std::fill(has_update_.begin(), has_update_.end(), false);
+        Base::build(a);
+    }
+
+    void build(const std::vector<value_type>& a) override {
+        build(a.data());
+    }
+
+    void set(const size_type index, const value_type& value) {
+        const size_type leaf = index + offset_;
+        push_path(leaf);
+        data_[leaf] = value;
+        pull_path(leaf);
+    }
+
+    void point_update(const size_type index, const update_type& update) {
+        range_update(index, index, update);
+    }
+
+    void range_update(const size_type left, const size_type right, const update_type& update) {
+        const size_type l = left + offset_;
+        const size_type r = right + offset_ + 1;
+        push_boundaries(l, r);
+        apply_canonical(l, r, update);
+        pull_boundaries(l, r);
+    }
+
+    value_type get(const size_type index) const
+    // pending updates of the ancestors are applied to the result, the tree is not modified
+    {
+        const size_type leaf = index + offset_;
+        value_type result = data_[leaf];
+        for (size_type level = 1; level <= height_; ++level) {
+            const size_type v = leaf >> level;
+            if (has_update_[v]) {
+                result = apply_update_(result, updates_[v], index, index);
+            }
+        }
+        return result;
+    }
+
+    value_type get(const size_type left, const size_type right) const
+    // instead of pushing the boundary paths, their pending updates are applied to the partial results:
+    // at every level the left result lies inside the left boundary node and the right result inside the right one
+    {
+        const size_type first = left + offset_;
+        const size_type last = right + offset_ + 1;
+        size_type l = first;
+        size_type r = last;
+        // the partial results cover leaves [first, left_end) and [right_begin, last)
+        size_type left_end = first;
+        size_type right_begin = last;
+        value_type left_result = default_value_;
+        value_type right_result = default_value_;
+        for (size_type level = 0; level <= height_; ++level, l >>= 1, r >>= 1) {
+            if (left_end != first && has_update_[first >> level]) {
+                left_result = apply_update_(left_result, updates_[first >> level], left, left_end - offset_ - 1);
+            }
+            if (right_begin != last && has_update_[(last - 1) >> level]) {
+                right_result = apply_update_(right_result, updates_[(last - 1) >> level], right_begin - offset_, right);
+            }
+            if (l >= r) {
+                continue;
+            }
+            if ((l & 1) != 0) {
+                left_result = merge_(left_result, data_[l]);
+                left_end = (++l) << level;
+            }
+            if ((r & 1) != 0) {
+                right_result = merge_(data_[--r], right_result);
+                right_begin = r << level;
+            }
+        }
+        return merge_(left_result, right_result);
+    }
+
+    value_type get_all() const {
+        return data_[1];
+    }
+
+    void process(const std::vector<Operation>& operations, std::vector<value_type>* results = nullptr)
+    // performs the operations in the given order, results of the queries are appended to results.
+    // Consecutive operations whose ranges overlap or touch form a run. The boundary paths of the union of the run
+    // are pushed once before its first update and pulled once after it, updates of the run push and pull only
+    // the nodes inside the union: nodes outside it are never tagged or read during the run.
+    // Queries do not modify the tree, so they are the same as get(left, right)
+    {
+        for (size_type begin = 0, end = 0; begin < operations.size(); begin = end) {
+            size_type run_left = operations[begin].left;
+            size_type run_right = operations[begin].right;
+            for (end = begin + 1; end < operations.size(); ++end) {
+                const Operation& operation = operations[end];
+                if (operation.left > run_right + 1 || operation.right + 1 < run_left) {
+                    break;
+                }
+                run_left = std::min(run_left, operation.left);
+                run_right = std::max(run_right, operation.right);
+            }
+            const size_type run_l = run_left + offset_;
+            const size_type run_r = run_right + offset_ + 1;
+            bool has_updates = false;
+            for (size_type i = begin; i < end; ++i) {
+                const Operation& operation = operations[i];
+                if (operation.is_query) {
+                    const value_type result = get(operation.left, operation.right);
+                    if (results != nullptr) {
+                        results->emplace_back(result);
+                    }
+                    continue;
+                }
+                if (!has_updates) {
+                    push_boundaries(run_l, run_r);
+                    has_updates = true;
+                }
+                const size_type l = operation.left + offset_;
+                const size_type r = operation.right + offset_ + 1;
+                const size_type left_height = std::min(height_, inner_height(l, run_l, run_r));
+                const size_type right_height = std::min(height_, inner_height(r - 1, run_l, run_r));
+                push_inner_boundaries(l, r, left_height, right_height);
+                apply_canonical(l, r, operation.update);
+                pull_inner_boundaries(l, r, left_height, right_height);
+            }
+            if (has_updates) {
+                pull_boundaries(run_l, run_r);
+            }
+        }
+    }
+
+    std::vector<update_type>& updates() {
+        return updates_;
+    }
+
+    const std::vector<update_type>& updates() const {
+        return updates_;
+    }
+
+    constexpr update_type default_update() const {
+        return default_update_;
+    }
+
+protected:
+    using Base::offset_;
+    using Base::data_;
+    using Base::merge_;
+    using Base::default_value_;
+
+private:
+    size_type height_;
+    // pending updates of inner nodes, leaves have none
+    std::vector<update_type> updates_;
+    // pushes of nodes without pending updates are skipped
+    std::vector<char> has_update_;
+    const update_type default_update_;
+    const apply_update_type apply_update_;
+    const merge_updates_type merge_updates_;
+
+    void apply_node(const size_type v, const size_type node_height, const update_type& update) {
+        const size_type left = (v << node_height) - offset_;
+        data_[v] = apply_update_(data_[v], update, left, left + (static_cast<size_type>(1) << node_height) - 1);
+        if (v < offset_) {
+            updates_[v] = merge_updates_(updates_[v], update);
+            has_update_[v] = true;
+        }
+    }
+
+    void push(const size_type v, const size_type node_height) {
+        if (!has_update_[v]) {
+            return;
+        }
+        apply_node(v << 1, node_height - 1, updates_[v]);
+        apply_node((v << 1) ^ 1, node_height - 1, updates_[v]);
+        updates_[v] = default_update_;
+        has_update_[v] = false;
+    }
+
+    void push_path(const size_type leaf) {
+        for (size_type level = height_; level >= 1; --level) {
+            push(leaf >> level, level);
+        }
+    }
+
+    void pull_path(size_type leaf) {
+        for (leaf >>= 1; leaf >= 1; leaf >>= 1) {
+            this->merge_children(leaf);
+        }
+    }
+
+    void push_boundaries(const size_type l, const size_type r)
+    // only nodes partially covered by [l, r) are pushed
+    {
+        for (size_type level = height_; level >= 1; --level) {
+            if (((l >> level) << level) != l) {
+                push(l >> level, level);
+            }
+            if (((r >> level) << level) != r) {
+                push((r - 1) >> level, level);
+            }
+        }
+    }
+
+    static size_type inner_height(const size_type leaf, const size_type run_l, const size_type run_r)
+    // the highest level at which the ancestor of the leaf lies inside [run_l, run_r), ancestors above it are partially covered
+    {
+        return std::min(bit_width(leaf ^ (run_l - 1)), bit_width(leaf ^ run_r)) - 1;
+    }
+
+    void push_inner_boundaries(const size_type l, const size_type r, const size_type left_height, const size_type right_height)
+    // nodes partially covered by [l, r) up to the given heights of the left and the right path,
+    // the nodes above them are pushed by the run
+    {
+        for (size_type level = std::max(left_height, right_height); level >= 1; --level) {
+            if (level <= left_height && ((l >> level) << level) != l) {
+                push(l >> level, level);
+            }
+            if (level <= right_height && ((r >> level) << level) != r) {
+                push((r - 1) >> level, level);
+            }
+        }
+    }
+
+    void apply_canonical(size_type l, size_type r, const update_type& update) {
+        for (size_type level = 0; l < r; l >>= 1, r >>= 1, ++level) {
+            if ((l & 1) != 0) {
+                apply_node(l++, level, update);
+            }
+            if ((r & 1) != 0) {
+                apply_node(--r, level, update);
+            }
+        }
+    }
+
+    void pull_boundaries(const size_type l, const size_type r) {
+        for (size_type level = 1; level <= height_; ++level) {
+            if (((l >> level) << level) != l) {
+                this->merge_children(l >> level);
+            }
+            if (((r >> level) << level) != r) {
+                this->merge_children((r - 1) >> level);
+            }
+        }
+    }
+
+    void pull_inner_boundaries(const size_type l, const size_type r, const size_type left_height, const size_type right_height)
+    // nodes inside the run are pulled at once, they can be read by the next operations of the run
+    {
+        for (size_type level = 1; level <= std::max(left_height, right_height); ++level) {
+            if (level <= left_height && ((l >> level) << level) != l) {
+                this->merge_children(l >> level);
+            }
+            if (level <= right_height && ((r >> level) << level) != r) {
+                this->merge_children((r - 1) >> level);
+            }
+        }
+    }
+};
@@ -0,0 +1,222 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+template<typename T, typename Merge>
+class PersistentSegmentTree {
+// path copying segment tree: every modification creates O(log n) new nodes and returns the root of a new version,
+// all older versions stay valid. Nodes live in one arena and refer to children by 32-bit indices;
+// node 0 is a shared empty node whose children are itself, so version 0 is the array of neutral values.
+// Ranges are inclusive
+public:
+    using size_type = std::size_t;
+    using value_type = T;
+    using merge_type = Merge;
+    using node_id_type = uint32_t;
+    using version_type = node_id_type;
+
+    static constexpr version_type kEmptyVersion = 0;
+
+    explicit PersistentSegmentTree(const size_type N, const merge_type& merge = merge_type(), const value_type& neutral = value_type(0)) :
+            elements_count_(N),
+            merge_(merge),
+            neutral_(neutral)
+    {
+        reset();
+    }
+
+    void reserve(const size_type nodes_count)
+    // a version built from scratch takes 2n - 1 nodes, every modification takes at most bit_width(n - 1) + 1 nodes
+    {
+        nodes_.reserve(nodes_count);
+    }
+
+    void reset()
+    // drops all versions at once, the memory is kept for reuse
+    {
+        nodes_.clear();
+        nodes_.emplace_back(Node{neutral_, 0, 0});
+    }
+
+    constexpr size_type elements_count() const {
+        return elements_count_;
+    }
+
+    size_type nodes_count() const {
+        return nodes_.size();
+    }
+
+    template<typename Iterator>
+    version_type build(Iterator first, Iterator last)
+    // new version holding the given values, elements after them are neutral
+    {
+        std::vector<value_type> values(first, last);
+        values.resize(elements_count_, neutral_);
+        return elements_count_ == 0 ? kEmptyVersion : build_impl(values, 0, elements_count_ - 1);
+    }
+
+    version_type build(const std::vector<value_type>& a) {
+        return build(a.cbegin(), a.cend());
+    }
+
+    version_type set(const version_type version, const size_type position, const value_type& value)
+    // new version with a[position] = value
+    {
+        return modify(version, position, value, false);
+    }
+
+    version_type add(const version_type version, const size_type position, const value_type& value)
+    // new version with a[position] = merge(a[position], value)
+    {
+        return modify(version, position, value, true);
+    }
+
+    value_type get(const version_type version, const size_type position) const {
+        if (elements_count_ == 0) {
+            return neutral_;
+        }
+        node_id_type v = version;
+        for (size_type l = 0, r = elements_count_ - 1; l < r; ) {
+            const size_type mid = (l + r) / 2;
+            if (position <= mid) {
+                v = nodes_[v].left;
+                r = mid;
+            } else {
+                v = nodes_[v].right;
+                l = mid + 1;
+            }
+        }
+        return nodes_[v].value;
+    }
+
+    value_type query(const version_type version, const size_type left, const size_type right) const {
+        struct Frame {
+            node_id_type v;
+            size_type l;
+            size_type r;
+        };
+        // right children are pushed before left ones, so covered nodes are merged from left to right
+        if (elements_count_ == 0) {
+            return neutral_;
+        }
+        Frame stack[2 * kMaxDepth];
+        size_type stack_size = 0;
+        stack[stack_size++] = Frame{version, 0, elements_count_ - 1};
+        value_type result = neutral_;
+        while (stack_size > 0) {
+            const Frame frame = stack[--stack_size];
+            if (frame.r < left || right < frame.l) {
+                continue;
+            }
+            if (left <= frame.l && frame.r <= right) {
+                result = merge_(result, nodes_[frame.v].value);
+                continue;
+            }
+            const size_type mid = (frame.l + frame.r) / 2;
+            stack[stack_size++] = Frame{nodes_[frame.v].right, mid + 1, frame.r};
+            stack[stack_size++] = Frame{nodes_[frame.v].left, frame.l, mid};
+        }
+        return result;
+    }
+
+    value_type query_all(const version_type version) const {
+        return nodes_[version].value;
+    }
+
+    size_type kth(const version_type from, const version_type to, value_type k) const
+    // for trees of counts merged by addition: the minimal position p such that the sum over [0, p]
+    // of the differences a_to - a_from is greater than k (k is 0-based); elements_count() if there is none.
+    // With version i holding counts of the first i array elements, kth(i, j, k) is the k-th smallest value of a[i..j)
+    {
+        if (elements_count_ == 0 || !(k < nodes_[to].value - nodes_[from].value)) {
+            return elements_count_;
+        }
+        node_id_type a = from;
+        node_id_type b = to;
+        size_type l = 0;
+        size_type r = elements_count_ - 1;
+        while (l < r) {
+            const size_type mid = (l + r) / 2;
+            const value_type left_count = nodes_[nodes_[b].left].value - nodes_[nodes_[a].left].value;
+            if (k < left_count) {
+                a = nodes_[a].left;
+                b = nodes_[b].left;
+                r = mid;
+            } else {
+                k -= left_count;
+                a = nodes_[a].right;
+                b = nodes_[b].right;
+                l = mid + 1;
+            }
+        }
+        return l;
+    }
+
+    size_type kth(const version_type version, const value_type k) const {
+        return kth(kEmptyVersion, version, k);
+    }
+
+private:
+    static constexpr size_type kMaxDepth = 64;
+
+    struct Node {
+        value_type value;
+        node_id_type left;
+        node_id_type right;
+    };
+
+    size_type elements_count_;
+    const merge_type merge_;
+    const value_type neutral_;
+    std::vector<Node> nodes_;
+
+    node_id_type create(const value_type& value, const node_id_type left, const node_id_type right) {
+        nodes_.emplace_back(Node{value, left, right});
+        return static_cast<node_id_type>(nodes_.size() - 1);
+    }
+
+    node_id_type build_impl(const std::vector<value_type>& values, const size_type l, const size_type r) {
+        if (l == r) {
+            return create(values[l], 0, 0);
+        }
+        const size_type mid = (l + r) / 2;
+        const node_id_type left = build_impl(values, l, mid);
+        const node_id_type right = build_impl(values, mid + 1, r);
+        return create(merge_(nodes_[left].value, nodes_[right].value), left, right);
+    }
+
+    version_type modify(const version_type version, const size_type position, const value_type& value, const bool accumulate) {
+        if (elements_count_ == 0) {
+            return version;
+        }
+        node_id_type path[kMaxDepth];
+        size_type depth = 0;
+        const node_id_type root = create(nodes_[version].value, nodes_[version].left, nodes_[version].right);
+        node_id_type v = root;
+        for (size_type l = 0, r = elements_count_ - 1; l < r; ) {
+            path[depth++] = v;
+            const size_type mid = (l + r) / 2;
+            if (position <= mid) {
+                const node_id_type child = nodes_[v].left;
+                const node_id_type copy = create(nodes_[child].value, nodes_[child].left, nodes_[child].right);
+                nodes_[v].left = copy;
+                v = copy;
+                r = mid;
+            } else {
+                const node_id_type child = nodes_[v].right;
+                const node_id_type copy = create(nodes_[child].value, nodes_[child].left, nodes_[child].right);
+                nodes_[v].right = copy;
+                v = copy;
+                l = mid + 1;
+            }
+        }
+        nodes_[v].value = (accumulate ? merge_(nodes_[v].value, value) : value);
+        while (depth > 0) {
+            const node_id_type u = path[--depth];
+            nodes_[u].value = merge_(nodes_[nodes_[u].left].value, nodes_[nodes_[u].right].value);
+        }
+        return root;
+    }
+};
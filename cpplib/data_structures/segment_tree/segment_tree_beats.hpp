@@ -0,0 +1,355 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "maths/bits.hpp"
+
+template<typename T, typename SumType = T>
+class SegmentTreeBeats {
+// Ji's segment tree beats: range chmin (a[i] = min(a[i], x)), range chmax, range add and range sum / min / max
+// in amortised O(log^2 n). Every node keeps its maximum, the strict second maximum and the number of maximums
+// (and the same for minimums), so a chmin that cuts only the maximums is applied to the node as a whole.
+// The tree is perfect with leaves starting at offset_ as in BaseSegmentTree, every field lives in its own array.
+// Boundary paths are pushed and pulled iteratively, recursion only descends into the canonical nodes
+// where the update can be neither skipped nor applied as a tag. Ranges are inclusive
+public:
+    using size_type = std::size_t;
+    using value_type = T;
+    using sum_type = SumType;
+
+    explicit SegmentTreeBeats(const size_type N) :
+            SegmentTreeBeats(std::vector<value_type>(N, value_type(0)))
+    {}
+
+    template<typename Iterator>
+    SegmentTreeBeats(Iterator first, Iterator last) :
+            SegmentTreeBeats(std::vector<value_type>(first, last))
+    {}
+
+    explicit SegmentTreeBeats(const std::vector<value_type>& a) :
+            elements_count_(a.size()),
+            offset_(bit_ceil(std::max<size_type>(a.size(), 1))),
+            height_(countr_zero(offset_)),
+            max1_(offset_ << 1),
+            max2_(offset_ << 1),
+            max_count_(offset_ << 1),
+            min1_(offset_ << 1),
+            min2_(offset_ << 1),
+            min_count_(offset_ << 1),
+            sum_(offset_ << 1),
+            lazy_add_(offset_ << 1)
+    {
+        build(a);
+    }
+
+    constexpr size_type elements_count() const {
+        return elements_count_;
+    }
+
+    void build(const std::vector<value_type>& a) {
+        for (size_type i = 0; i < offset_; ++i) {
+            if (i < elements_count_) {
+                set_leaf(offset_ + i, a[i]);
+            } else {
+                clear_leaf(offset_ + i);
+            }
+        }
+        std::fill(lazy_add_.begin(), lazy_add_.end(), value_type(0));
+        for (size_type v = offset_ - 1; v >= 1; --v) {
+            pull(v);
+        }
+    }
+
+    void chmin(const size_type left, const size_type right, const value_type& value)
+    // a[i] = min(a[i], value) for i in [left, right]
+    {
+        modify(left, right,
+               [&](const size_type v) { return max1_[v] <= value; },
+               [&](const size_type v) { return max2_[v] < value; },
+               [&](const size_type v, size_type) { apply_chmin(v, value); });
+    }
+
+    void chmax(const size_type left, const size_type right, const value_type& value)
+    // a[i] = max(a[i], value) for i in [left, right]
+    {
+        modify(left, right,
+               [&](const size_type v) { return min1_[v] >= value; },
+               [&](const size_type v) { return min2_[v] > value; },
+               [&](const size_type v, size_type) { apply_chmax(v, value); });
+    }
+
+    void add(const size_type left, const size_type right, const value_type& value) {
+        modify(left, right,
+               [](size_type) { return false; },
+               [](size_type) { return true; },
+               [&](const size_type v, const size_type length) { apply_add(v, length, value); });
+    }
+
+    void set(const size_type position, const value_type& value) {
+        const size_type leaf = position + offset_;
+        for (size_type level = height_; level >= 1; --level) {
+            push(leaf >> level, level);
+        }
+        set_leaf(leaf, value);
+        for (size_type v = leaf >> 1; v >= 1; v >>= 1) {
+            pull(v);
+        }
+    }
+
+    sum_type sum(const size_type left, const size_type right) {
+        sum_type result = sum_type(0);
+        visit(left, right, [&](const size_type v) { result += sum_[v]; });
+        return result;
+    }
+
+    value_type max(const size_type left, const size_type right) {
+        value_type result = kMinValue;
+        visit(left, right, [&](const size_type v) { result = std::max(result, max1_[v]); });
+        return result;
+    }
+
+    value_type min(const size_type left, const size_type right) {
+        value_type result = kMaxValue;
+        visit(left, right, [&](const size_type v) { result = std::min(result, min1_[v]); });
+        return result;
+    }
+
+    value_type get(const size_type position) {
+        return max(position, position);
+    }
+
+private:
+    static constexpr value_type kMinValue = std::numeric_limits<value_type>::lowest();
+    static constexpr value_type kMaxValue = std::numeric_limits<value_type>::max();
+
+    size_type elements_count_;
+    size_type offset_;
+    size_type height_;
+    std::vector<value_type> max1_;
+    // strict second maximum, kMinValue if all values of the segment are equal
+    std::vector<value_type> max2_;
+    std::vector<size_type> max_count_;
+    std::vector<value_type> min1_;
+    std::vector<value_type> min2_;
+    std::vector<size_type> min_count_;
+    std::vector<sum_type> sum_;
+    std::vector<value_type> lazy_add_;
+
+    void set_leaf(const size_type v, const value_type& value) {
+        max1_[v] = value;
+        max2_[v] = kMinValue;
+        max_count_[v] = 1;
+        min1_[v] = value;
+        min2_[v] = kMaxValue;
+        min_count_[v] = 1;
+        sum_[v] = static_cast<sum_type>(value);
+    }
+
+    void clear_leaf(const size_type v)
+    // leaves after the elements: never selected by chmin or chmax pushes, skipped by add pushes
+    {
+        max1_[v] = max2_[v] = kMinValue;
+        min1_[v] = min2_[v] = kMaxValue;
+        max_count_[v] = min_count_[v] = 0;
+        sum_[v] = sum_type(0);
+    }
+
+    size_type length(const size_type v, const size_type level) const
+    // number of elements in the segment of the node, leaves after the elements are not counted
+    {
+        const size_type left = (v << level) - offset_;
+        return left >= elements_count_ ? 0 : std::min(static_cast<size_type>(1) << level, elements_count_ - left);
+    }
+
+    void apply_add(const size_type v, const size_type length, const value_type& value) {
+        max1_[v] += value;
+        if (max2_[v] != kMinValue) {
+            max2_[v] += value;
+        }
+        min1_[v] += value;
+        if (min2_[v] != kMaxValue) {
+            min2_[v] += value;
+        }
+        sum_[v] += static_cast<sum_type>(value) * static_cast<sum_type>(length);
+        lazy_add_[v] += value;
+    }
+
+    void apply_chmin(const size_type v, const value_type& value)
+    // only the maximums change, requires max2 < value < max1 for inner nodes and value < max1 for leaves
+    {
+        sum_[v] -= (static_cast<sum_type>(max1_[v]) - static_cast<sum_type>(value)) * static_cast<sum_type>(max_count_[v]);
+        if (min1_[v] == max1_[v]) {
+            min1_[v] = value;
+        } else if (min2_[v] == max1_[v]) {
+            min2_[v] = value;
+        }
+        max1_[v] = value;
+    }
+
+    void apply_chmax(const size_type v, const value_type& value)
+    // only the minimums change, requires min2 > value > min1 for inner nodes and value > min1 for leaves
+    {
+        sum_[v] += (static_cast<sum_type>(value) - static_cast<sum_type>(min1_[v])) * static_cast<sum_type>(min_count_[v]);
+        if (max1_[v] == min1_[v]) {
+            max1_[v] = value;
+        } else if (max2_[v] == min1_[v]) {
+            max2_[v] = value;
+        }
+        min1_[v] = value;
+    }
+
+    void push(const size_type v, const size_type level) {
+        for (size_type child = (v << 1); child <= ((v << 1) ^ 1); ++child) {
+            if (lazy_add_[v] != value_type(0)) {
+                const size_type child_length = length(child, level - 1);
+                if (child_length > 0) {
+                    apply_add(child, child_length, lazy_add_[v]);
+                }
+            }
+            if (max1_[child] > max1_[v]) {
+                apply_chmin(child, max1_[v]);
+            }
+            if (min1_[child] < min1_[v]) {
+                apply_chmax(child, min1_[v]);
+            }
+        }
+        lazy_add_[v] = value_type(0);
+    }
+
+    void pull(const size_type v) {
+        const size_type l = v << 1;
+        const size_type r = (v << 1) ^ 1;
+        sum_[v] = sum_[l] + sum_[r];
+        if (max1_[l] == max1_[r]) {
+            max1_[v] = max1_[l];
+            max2_[v] = std::max(max2_[l], max2_[r]);
+            max_count_[v] = max_count_[l] + max_count_[r];
+        } else if (max1_[l] > max1_[r]) {
+            max1_[v] = max1_[l];
+            max2_[v] = std::max(max2_[l], max1_[r]);
+            max_count_[v] = max_count_[l];
+        } else {
+            max1_[v] = max1_[r];
+            max2_[v] = std::max(max1_[l], max2_[r]);
+            max_count_[v] = max_count_[r];
+        }
+        if (min1_[l] == min1_[r]) {
+            min1_[v] = min1_[l];
+            min2_[v] = std::min(min2_[l], min2_[r]);
+            min_count_[v] = min_count_[l] + min_count_[r];
+        } else if (min1_[l] < min1_[r]) {
+            min1_[v] = min1_[l];
+            min2_[v] = std::min(min2_[l], min1_[r]);
+            min_count_[v] = min_count_[l];
+        } else {
+            min1_[v] = min1_[r];
+            min2_[v] = std::min(min1_[l], min2_[r]);
+            min_count_[v] = min_count_[r];
+        }
+    }
+
+    void push_boundaries(const size_type l, const size_type r)
+    // only nodes partially covered by [l, r) are pushed
+    {
+        for (size_type level = height_; level >= 1; --level) {
+            if (((l >> level) << level) != l) {
+                push(l >> level, level);
+            }
+            if (((r >> level) << level) != r) {
+                push((r - 1) >> level, level);
+            }
+        }
+    }
+
+    template<typename Break, typename Tag, typename Apply>
+    void modify(const size_type left, const size_type right, Break is_break, Tag is_tag, Apply apply)
+    // is_break: the update does not change the node, is_tag: the update can be applied to the node as a whole.
+    // Leaves are always applied, whatever is_tag says, so apply has to handle a single element.
+    // A boundary node which breaks holds all canonical nodes of its side below it, so that side stops there
+    {
+        if (elements_count_ == 0) {
+            return;
+        }
+        const size_type l = left + offset_;
+        const size_type r = right + offset_ + 1;
+        // levels of the highest breaking boundary nodes, 0 if there are none
+        size_type left_stop = 0;
+        size_type right_stop = 0;
+        for (size_type level = height_; level >= 1; --level) {
+            if (left_stop == 0 && ((l >> level) << level) != l) {
+                if (is_break(l >> level)) {
+                    left_stop = level;
+                } else {
+                    push(l >> level, level);
+                }
+            }
+            if (right_stop == 0 && ((r >> level) << level) != r) {
+                if (is_break((r - 1) >> level)) {
+                    right_stop = level;
+                } else {
+                    push((r - 1) >> level, level);
+                }
+            }
+        }
+        for (size_type a = l, b = r, level = 0; a < b; a >>= 1, b >>= 1, ++level) {
+            if ((a & 1) != 0) {
+                if (level >= left_stop) {
+                    modify_node(a, level, is_break, is_tag, apply);
+                }
+                ++a;
+            }
+            if ((b & 1) != 0) {
+                --b;
+                if (level >= right_stop) {
+                    modify_node(b, level, is_break, is_tag, apply);
+                }
+            }
+        }
+        for (size_type level = 1; level <= height_; ++level) {
+            if (level > left_stop && ((l >> level) << level) != l) {
+                pull(l >> level);
+            }
+            if (level > right_stop && ((r >> level) << level) != r) {
+                pull((r - 1) >> level);
+            }
+        }
+    }
+
+    template<typename Break, typename Tag, typename Apply>
+    void modify_node(const size_type v, const size_type level, Break& is_break, Tag& is_tag, Apply& apply)
+    // the node is covered by the range, its children are visited only if the update breaks the tag condition
+    {
+        if (is_break(v)) {
+            return;
+        }
+        if (level == 0 || is_tag(v)) {
+            apply(v, static_cast<size_type>(1) << level);
+            return;
+        }
+        push(v, level);
+        modify_node(v << 1, level - 1, is_break, is_tag, apply);
+        modify_node((v << 1) ^ 1, level - 1, is_break, is_tag, apply);
+        pull(v);
+    }
+
+    template<typename Callback>
+    void visit(const size_type left, const size_type right, Callback callback)
+    // calls callback for the canonical nodes of [left, right], not necessarily from left to right
+    {
+        if (elements_count_ == 0) {
+            return;
+        }
+        size_type l = left + offset_;
+        size_type r = right + offset_ + 1;
+        push_boundaries(l, r);
+        for (; l < r; l >>= 1, r >>= 1) {
+            if ((l & 1) != 0) {
+                callback(l++);
+            }
+            if ((r & 1) != 0) {
+                callback(--r);
+            }
+        }
+    }
+};
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+template<typename T, typename Merge, std::size_t B = 16>
+class WideSegmentTree {
+// B-ary segment tree. Layer 0 holds the elements, value of layer k is the aggregate of a block of B consecutive
+// values of layer k - 1. Every block of an upper layer also stores its prefix and suffix aggregates, so a query
+// takes one lookup per layer plus at most three scans inside a block, and an update recomputes one contiguous
+// block per layer: O(log_B n) cache lines instead of O(log_2 n). Extra memory is about 3n / (B - 1) values.
+// Same build / update / query surface as BottomUpSegmentTree, ranges are inclusive
+public:
+    using size_type = std::size_t;
+    using value_type = T;
+    using merge_type = Merge;
+
+    static constexpr size_type kBranching = B;
+
+    static_assert(B >= 2, "Branching factor should be at least 2");
+
+    explicit WideSegmentTree(const size_type N, const merge_type& merge = merge_type(), const value_type& neutral = value_type(0)) :
+            elements_count_(N),
+            data_(round_up(std::max<size_type>(N, 1)), neutral),
+            merge_(merge),
+            neutral_(neutral)
+    {
+        layer_offset_.emplace_back(0);
+        layer_offset_.emplace_back(0);
+        for (size_type layer_size = data_.size(); layer_size > B; ) {
+            layer_size = round_up(layer_size / B);
+            layer_offset_.emplace_back(layer_offset_.back() + layer_size);
+        }
+        value_.assign(layer_offset_.back(), neutral_);
+        prefix_.assign(layer_offset_.back(), neutral_);
+        suffix_.assign(layer_offset_.back(), neutral_);
+    }
+
+    template<typename Iterator>
+    WideSegmentTree(Iterator first, Iterator last, const merge_type& merge = merge_type(), const value_type& neutral = value_type(0)) :
+            WideSegmentTree(std::distance(first, last), merge, neutral)
+    {
+        build(first, last);
+    }
+
+    constexpr size_type elements_count() const {
+        return elements_count_;
+    }
+
+    constexpr size_type layers_count() const {
+        return layer_offset_.size() - 1;
+    }
+
+    constexpr value_type neutral() const {
+        return neutral_;
+    }
+
+    const std::vector<value_type>& data() const {
+        return data_;
+    }
+
+    template<typename Iterator>
+    void build(Iterator first, Iterator last)
+    // O(n), elements after the given ones are set to neutral
+    {
+        std::fill(std::copy(first, last, data_.begin()), data_.end(), neutral_);
+        for (size_type layer = 1; layer < layers_count(); ++layer) {
+            const size_type begin = layer_offset_[layer];
+            const size_type children_count = (layer == 1 ? data_.size() : layer_offset_[layer] - layer_offset_[layer - 1]);
+            std::fill(value_.begin() + begin, value_.begin() + layer_offset_[layer + 1], neutral_);
+            for (size_type i = 0; i * B < children_count; ++i) {
+                value_[begin + i] = child_aggregate(layer, i);
+            }
+            for (size_type i = begin; i < layer_offset_[layer + 1]; i += B) {
+                recalculate_block(i, i, i + B - 1);
+            }
+        }
+    }
+
+    void build(const value_type* a) {
+        build(a, a + elements_count_);
+    }
+
+    void build(const std::vector<value_type>& a) {
+        build(a.cbegin(), a.cend());
+    }
+
+    value_type get(const size_type position) const {
+        return data_[position];
+    }
+
+    void update(size_type position, const value_type& value) {
+        data_[position] = value;
+        for (size_type layer = 1; layer < layers_count(); ++layer) {
+            position /= B;
+            const size_type index = layer_offset_[layer] + position;
+            value_[index] = child_aggregate(layer, position);
+            recalculate_block(layer_offset_[layer] + position / B * B, index, index);
+        }
+    }
+
+    value_type query(size_type left, size_type right) const {
+        if (left / B == right / B) {
+            return merge_range(data_.data(), left, right + 1);
+        }
+        value_type left_result = merge_range(data_.data(), left, (left / B + 1) * B);
+        value_type right_result = merge_range(data_.data(), right / B * B, right + 1);
+        for (size_type layer = 1; ; ++layer) {
+            left = left / B + 1;
+            right = right / B;
+            if (left == right) {
+                break;
+            }
+            --right;
+            const size_type begin = layer_offset_[layer];
+            if (left / B == right / B) {
+                left_result = merge_(left_result, merge_range(value_.data() + begin, left, right + 1));
+                break;
+            }
+            left_result = merge_(left_result, suffix_[begin + left]);
+            right_result = merge_(prefix_[begin + right], right_result);
+        }
+        return merge_(left_result, right_result);
+    }
+
+private:
+    size_type elements_count_;
+    // layer 0 is data_, layer k > 0 occupies [layer_offset_[k], layer_offset_[k + 1]) of value_, prefix_ and suffix_;
+    // layer sizes are multiples of B and the last layer is a single block
+    std::vector<size_type> layer_offset_;
+    std::vector<value_type> data_;
+    std::vector<value_type> value_;
+    std::vector<value_type> prefix_;
+    std::vector<value_type> suffix_;
+    const merge_type merge_;
+    const value_type neutral_;
+
+    static constexpr size_type round_up(const size_type size) {
+        return (size + B - 1) / B * B;
+    }
+
+    value_type merge_range(const value_type* values, const size_type from, const size_type to) const {
+        value_type result = neutral_;
+        for (size_type i = from; i < to; ++i) {
+            result = merge_(result, values[i]);
+        }
+        return result;
+    }
+
+    value_type child_aggregate(const size_type layer, const size_type index) const
+    // aggregate of the block of layer - 1 under value index of the layer
+    {
+        if (layer == 1) {
+            return merge_range(data_.data(), index * B, index * B + B);
+        }
+        return prefix_[layer_offset_[layer - 1] + index * B + B - 1];
+    }
+
+    void recalculate_block(const size_type begin, const size_type prefix_from, const size_type suffix_to)
+    // prefixes starting from prefix_from and suffixes up to suffix_to of the block starting at begin
+    {
+        const size_type end = begin + B;
+        prefix_[prefix_from] = (prefix_from == begin ? value_[begin] : merge_(prefix_[prefix_from - 1], value_[prefix_from]));
+        for (size_type i = prefix_from + 1; i < end; ++i) {
+            prefix_[i] = merge_(prefix_[i - 1], value_[i]);
+        }
+        suffix_[suffix_to] = (suffix_to + 1 == end ? value_[suffix_to] : merge_(value_[suffix_to], suffix_[suffix_to + 1]));
+        for (size_type i = suffix_to; i-- > begin; ) {
+            suffix_[i] = merge_(value_[i], suffix_[i + 1]);
+        }
+    }
+};
@@ -1,8 +1,12 @@
 #pragma once
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "segment_tree/bottom_up_segment_tree.hpp"
 
@@ -114,10 +118,217 @@ public:
 
 };
 
-void LCPArray(int lcp[], const int sa[], const char * s, const int n);
-void LCPArray(int lcp[], const int sa[], const std::string& s);
+class SuffixArraySais {
+// SA-IS suffix array construction in O(n) over 32-bit indices for integer alphabets [0..alphabet).
+// All recursion levels share one workspace: suffix types packed in bits and two bucket arrays of the current level
+// (types and buckets of a level are recomputed after the recursive call, so the child overwrites them).
+// The reduced problem is stored and solved inside sa itself, so the workspace is n / 32 + max(2 alphabet, n) words
+// and stays allocated between builds. Texts are limited to kMaxLength chars
+public:
+    using index_type = int32_t;
+
+    static constexpr std::size_t kMaxLength = static_cast<std::size_t>(std::numeric_limits<index_type>::max());
+
+    void reserve(const std::size_t n, const std::size_t alphabet) {
+        const std::size_t size = ((n + 31) >> 5) + std::max(2 * alphabet, n) + 2;
+        if (workspace_.size() < size) {
+            workspace_.resize(size);
+        }
+    }
+
+    template<typename Char>
+    void build(const Char* s, const index_type n, const index_type alphabet, index_type* sa)
+    // REQUIRE: all chars in interval [0..alphabet)
+    {
+        reserve(n, alphabet);
+        sais(s, sa, n, alphabet, workspace_.data());
+    }
+
+    bool build(const std::string& s, index_type* sa)
+    // returns false and changes nothing if s is longer than kMaxLength
+    {
+        if (s.length() > kMaxLength) {
+            return false;
+        }
+        build(reinterpret_cast<const unsigned char*>(s.data()), static_cast<index_type>(s.length()), 256, sa);
+        return true;
+    }
+
+    bool build(const std::string& s, std::vector<index_type>* sa)
+    // returns false and changes nothing if s is longer than kMaxLength
+    {
+        if (s.length() > kMaxLength) {
+            return false;
+        }
+        sa->resize(s.length());
+        return build(s, sa->data());
+    }
+
+private:
+    std::vector<uint32_t> workspace_;
+
+    template<typename Char>
+    static index_type key(const Char c) {
+        return static_cast<index_type>(static_cast<typename std::make_unsigned<Char>::type>(c));
+    }
+
+    static bool is_s(const uint32_t* types, const index_type i) {
+        return ((types[i >> 5] >> (i & 31)) & 1) != 0;
+    }
+
+    static bool is_lms(const uint32_t* types, const index_type i) {
+        return i > 0 && is_s(types, i) && !is_s(types, i - 1);
+    }
+
+    template<typename Char>
+    static void classify(const Char* s, const index_type n, const index_type alphabet, uint32_t* types, uint32_t* count)
+    // types of suffixes (the last one is L) and sizes of buckets
+    {
+        std::fill_n(types, (static_cast<std::size_t>(n) + 31) >> 5, 0);
+        std::fill_n(count, alphabet, 0);
+        bool next_s = false;
+        ++count[key(s[n - 1])];
+        for (index_type i = n - 2; i >= 0; --i) {
+            next_s = (key(s[i]) < key(s[i + 1]) || (key(s[i]) == key(s[i + 1]) && next_s));
+            if (next_s) {
+                types[i >> 5] |= (1u << (i & 31));
+            }
+            ++count[key(s[i])];
+        }
+    }
+
+    static void bucket_starts(const uint32_t* count, const index_type alphabet, uint32_t* bucket) {
+        for (index_type c = 0, sum = 0; c < alphabet; ++c) {
+            bucket[c] = sum;
+            sum += count[c];
+        }
+    }
+
+    static void bucket_ends(const uint32_t* count, const index_type alphabet, uint32_t* bucket) {
+        for (index_type c = 0, sum = 0; c < alphabet; ++c) {
+            sum += count[c];
+            bucket[c] = sum;
+        }
+    }
+
+    template<typename Char>
+    static void induce(const Char* s, index_type* sa, const index_type n, const index_type alphabet,
+                       const uint32_t* types, const uint32_t* count, uint32_t* bucket)
+    // sorts L suffixes from the LMS suffixes placed at the ends of their buckets, then S suffixes from L ones
+    {
+        bucket_starts(count, alphabet, bucket);
+        sa[bucket[key(s[n - 1])]++] = n - 1;
+        for (index_type i = 0; i < n; ++i) {
+            const index_type v = sa[i] - 1;
+            if (v >= 0 && !is_s(types, v)) {
+                sa[bucket[key(s[v])]++] = v;
+            }
+        }
+        bucket_ends(count, alphabet, bucket);
+        for (index_type i = n - 1; i >= 0; --i) {
+            const index_type v = sa[i] - 1;
+            if (v >= 0 && is_s(types, v)) {
+                sa[--bucket[key(s[v])]] = v;
+            }
+        }
+    }
+
+    template<typename Char>
+    static void sais(const Char* s, index_type* sa, const index_type n, const index_type alphabet, uint32_t* workspace) {
+        if (n <= 2) {
+            if (n == 2) {
+                const bool ordered = key(s[0]) < key(s[1]);
+                sa[0] = (ordered ? 0 : 1);
+                sa[1] = (ordered ? 1 : 0);
+            } else if (n == 1) {
+                sa[0] = 0;
+            }
+            return;
+        }
+        uint32_t* types = workspace;
+        uint32_t* count = types + ((static_cast<std::size_t>(n) + 31) >> 5);
+        uint32_t* bucket = count + alphabet;
+
+        // LMS suffixes in text order, sorted by their LMS substrings after the induction
+        classify(s, n, alphabet, types, count);
+        bucket_ends(count, alphabet, bucket);
+        std::fill_n(sa, n, -1);
+        for (index_type i = n - 1; i >= 1; --i) {
+            if (is_lms(types, i)) {
+                sa[--bucket[key(s[i])]] = i;
+            }
+        }
+        induce(s, sa, n, alphabet, types, count, bucket);
+        index_type m = 0;
+        for (index_type i = 0; i < n; ++i) {
+            if (is_lms(types, sa[i])) {
+                sa[m++] = sa[i];
+            }
+        }
+
+        // LMS positions are at least two apart, so sa[m + p / 2] is a free slot for the LMS suffix p:
+        // first the length of its LMS substring, then its name
+        std::fill(sa + m, sa + n, -1);
+        for (index_type i = n - 1, next = n; i >= 1; --i) {
+            if (is_lms(types, i)) {
+                sa[m + (i >> 1)] = next - i;
+                next = i;
+            }
+        }
+        index_type names = 0;
+        for (index_type i = 0, previous = -1, previous_length = 0; i < m; ++i) {
+            const index_type p = sa[i];
+            const index_type length = sa[m + (p >> 1)];
+            bool differ = (previous < 0 || length != previous_length || p + length == n || previous + length == n);
+            for (index_type k = 0; !differ && k <= length; ++k) {
+                differ = (key(s[p + k]) != key(s[previous + k]));
+            }
+            names += (differ ? 1 : 0);
+            previous = p;
+            previous_length = length;
+            sa[m + (p >> 1)] = names - 1;
+        }
+        for (index_type i = n - 1, j = n; i >= m; --i) {
+            if (sa[i] >= 0) {
+                sa[--j] = sa[i];
+            }
+        }
+
+        // the reduced string is in sa[n - m, n), its suffix array goes to sa[0, m)
+        index_type* reduced = sa + n - m;
+        if (names < m) {
+            sais(reduced, sa, m, names, workspace);
+            classify(s, n, alphabet, types, count);
+        } else {
+            for (index_type i = 0; i < m; ++i) {
+                sa[reduced[i]] = i;
+            }
+        }
+        for (index_type i = 1, j = 0; i < n; ++i) {
+            if (is_lms(types, i)) {
+                reduced[j++] = i;
+            }
+        }
+        for (index_type i = 0; i < m; ++i) {
+            sa[i] = reduced[sa[i]];
+        }
+
+        // sorted LMS suffixes are moved to the ends of their buckets, keeping their order
+        bucket_ends(count, alphabet, bucket);
+        std::fill(sa + m, sa + n, -1);
+        for (index_type i = m - 1; i >= 0; --i) {
+            const index_type p = sa[i];
+            sa[i] = -1;
+            sa[--bucket[key(s[p])]] = p;
+        }
+        induce(s, sa, n, alphabet, types, count, bucket);
+    }
+};
+
+inline void LCPArray(int lcp[], const int sa[], const char * s, const int n);
+inline void LCPArray(int lcp[], const int sa[], const std::string& s);
 
-void suffixArrayCyclic(int sa[], const char * s, int n, const int alphabet = 27)
+inline void suffixArrayCyclic(int sa[], const char * s, int n, const int alphabet = 27)
 // building suffix array for cyclic shifts, O(n log n)
 // to prevent using cyclic shifts consider n = n + 1; s[n] = 0;
 {
@@ -129,13 +340,13 @@ void suffixArrayCyclic(int sa[], const char * s, int n, const int alphabet = 27)
     }
     std::fill_n(cnt, alphabet, 0);
     for (int i = 0; i < n; ++i) {
-        ++cnt[s[i]];
+        ++cnt[static_cast<unsigned char>(s[i])];
     }
     for (int i = 1; i < alphabet; ++i) {
         cnt[i] += cnt[i - 1];
     }
     for (int i = 0; i < n; ++i) {
-        sa[--cnt[s[i]]] = i;
+        sa[--cnt[static_cast<unsigned char>(s[i])]] = i;
     }
     c[0][sa[0]] = 0;
     int classes = 1;
@@ -181,14 +392,14 @@ void suffixArrayCyclic(int sa[], const char * s, int n, const int alphabet = 27)
     }
 }
 
-void suffixArrayCyclic(int sa[], const std::string& s, const int alphabet = 27)
+inline void suffixArrayCyclic(int sa[], const std::string& s, const int alphabet = 27)
 // building suffix array for cyclic shifts, O(n log n)
 // to prevent using cyclic shifts consider n = n + 1; s[n] = 0;
 {
     suffixArrayCyclic(sa, s.c_str(), s.length(), alphabet);
 }
 
-void suffixLCPArrayCyclic(int sa[], int lcp[], const char * s, const int n, const int alphabet = 27)
+inline void suffixLCPArrayCyclic(int sa[], int lcp[], const char * s, const int n, const int alphabet = 27)
 // building suffix and LCP array for cyclic shifts, O(n log^2 n)
 // to prevent using cyclic shifts consider n = n + 1; s[n] = 0;
 {
@@ -199,7 +410,7 @@ void suffixLCPArrayCyclic(int sa[], int lcp[], const char * s, const int n, cons
         }
         return (y == -1 || arr[x] < arr[y] ? x : y);
     };
-    static BottomUpSegmentTree<int> tree(n, comparator, -1);
+    BottomUpSegmentTree<int, decltype(comparator)> tree(n, comparator, -1);
     cnt = new int[std::max(255, n)];
     pn = new int[n];
     lpos = new int[n];
@@ -217,13 +428,13 @@ void suffixLCPArrayCyclic(int sa[], int lcp[], const char * s, const int n, cons
     }
     std::fill_n(cnt, alphabet, 0);
     for (int i = 0; i < n; ++i) {
-        ++cnt[s[i]];
+        ++cnt[static_cast<unsigned char>(s[i])];
     }
     for (int i = 1; i < alphabet; ++i) {
         cnt[i] += cnt[i - 1];
     }
     for (int i = 0; i < n; ++i) {
-        sa[--cnt[s[i]]] = i;
+        sa[--cnt[static_cast<unsigned char>(s[i])]] = i;
     }
     c[0][sa[0]] = 0;
     int classes = 1;
@@ -295,14 +506,14 @@ void suffixLCPArrayCyclic(int sa[], int lcp[], const char * s, const int n, cons
     }
 }
 
-void suffixLCPArrayCyclic(int sa[], int lcp[], const std::string& s, const int alphabet = 27)
+inline void suffixLCPArrayCyclic(int sa[], int lcp[], const std::string& s, const int alphabet = 27)
 // building suffix and LCP array for cyclic shifts, O(n log^2 n)
 // to prevent using cyclic shifts consider n = n + 1; s[n] = 0;
 {
     suffixLCPArrayCyclic(sa, lcp, s.c_str(), s.length(), alphabet);
 }
 
-void suffixArray(int sa[], const char * s, const int n, const int alphabet)
+inline void suffixArray(int sa[], const char * s, const int n, const int alphabet)
 // constructing suffix array in O(N)
 // REQUIRE: all chars in interval [0..alphabet)
 {
@@ -319,14 +530,14 @@ void suffixArray(int sa[], const char * s, const int n, const int alphabet)
     delete[] str;
 }
 
-void suffixArray(int sa[], const std::string& s, const int alphabet)
+inline void suffixArray(int sa[], const std::string& s, const int alphabet)
 // constructing suffix array in O(N)
 // REQUIRE: all chars in interval [0..alphabet)
 {
     suffixArray(sa, s.c_str(), s.length(), alphabet);
 }
 
-void LCPArray(int lcp[], const int sa[], const char * s, const int n)
+inline void LCPArray(int lcp[], const int sa[], const char * s, const int n)
 // constructing LCP array using suffix array in O(N)
 {
     int k = 0;
@@ -349,7 +560,7 @@ void LCPArray(int lcp[], const int sa[], const char * s, const int n)
     delete[] rank;
 }
 
-void LCPArray(int lcp[], const int sa[], const std::string& s)
+inline void LCPArray(int lcp[], const int sa[], const std::string& s)
 // constructing LCP array using suffix array in O(N)
 {
     LCPArray(lcp, sa, s.c_str(), s.length());
@@ -0,0 +1,225 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "collections/rank_select_bitvector.hpp"
+#include "maths/bits.hpp"
+
+template<typename T = uint32_t>
+class WaveletMatrix {
+// static sequence of unsigned integers below 2^bits_count. Level i stores bit (bits_count - 1 - i) of every element
+// in a RankSelectBitvector, then the elements are stably reordered by that bit, zeros first; zeros_count_[i]
+// is the number of zeros on level i. Takes n * bits_count bits plus the rank/select directories,
+// every query is O(bits_count) rank operations. Position ranges [left, right) and value ranges [lower, upper) are half-open
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static_assert(std::is_unsigned<value_type>::value, "Values should be unsigned");
+
+    WaveletMatrix() = default;
+
+    explicit WaveletMatrix(const std::vector<value_type>& a, const size_type bits_count = 0) {
+        build(a, bits_count);
+    }
+
+    void build(std::vector<value_type> a, size_type bits_count = 0)
+    // bits_count = 0 takes the bit width of the maximal element
+    {
+        if (bits_count == 0) {
+            const value_type max_value = (a.empty() ? 0 : *std::max_element(a.cbegin(), a.cend()));
+            bits_count = std::max<size_type>(bit_width(max_value), 1);
+        }
+        size_ = a.size();
+        levels_.assign(bits_count, RankSelectBitvector());
+        zeros_count_.assign(bits_count, 0);
+        std::vector<value_type> ones;
+        for (size_type level = 0; level < bits_count; ++level) {
+            const size_type bit = bits_count - 1 - level;
+            RankSelectBitvector& bits = levels_[level];
+            bits.init(size_);
+            ones.clear();
+            size_type zeros = 0;
+            for (size_type i = 0; i < size_; ++i) {
+                if (((a[i] >> bit) & 1) != 0) {
+                    bits.set(i);
+                    ones.emplace_back(a[i]);
+                } else {
+                    a[zeros++] = a[i];
+                }
+            }
+            bits.build();
+            zeros_count_[level] = zeros;
+            std::copy(ones.cbegin(), ones.cend(), a.begin() + zeros);
+        }
+    }
+
+    size_type size() const {
+        return size_;
+    }
+
+    size_type bits_count() const {
+        return levels_.size();
+    }
+
+    value_type access(size_type position) const {
+        value_type result = 0;
+        for (size_type level = 0; level < bits_count(); ++level) {
+            const RankSelectBitvector& bits = levels_[level];
+            if (bits[position]) {
+                result |= static_cast<value_type>(1) << (bits_count() - 1 - level);
+                position = zeros_count_[level] + bits.rank1(position);
+            } else {
+                position = bits.rank0(position);
+            }
+        }
+        return result;
+    }
+
+    value_type operator[](const size_type position) const {
+        return access(position);
+    }
+
+    size_type rank(const value_type value, const size_type position) const
+    // occurrences of value in [0, position)
+    {
+        if (!fits(value)) {
+            return 0;
+        }
+        size_type left = 0;
+        size_type right = position;
+        descend(value, &left, &right);
+        return right - left;
+    }
+
+    size_type select(const value_type value, const size_type k) const
+    // position of the k-th (0-based) occurrence of value, size() if there are not enough of them
+    {
+        if (!fits(value)) {
+            return size_;
+        }
+        size_type left = 0;
+        size_type right = size_;
+        descend(value, &left, &right);
+        if (right - left <= k) {
+            return size_;
+        }
+        size_type position = left + k;
+        for (size_type level = bits_count(); level-- > 0; ) {
+            const RankSelectBitvector& bits = levels_[level];
+            if (((value >> (bits_count() - 1 - level)) & 1) != 0) {
+                position = bits.select1(position - zeros_count_[level]);
+            } else {
+                position = bits.select0(position);
+            }
+        }
+        return position;
+    }
+
+    value_type kth_smallest(size_type left, size_type right, size_type k) const
+    // k-th (0-based) smallest value of [left, right), k < right - left
+    {
+        value_type result = 0;
+        for (size_type level = 0; level < bits_count(); ++level) {
+            const RankSelectBitvector& bits = levels_[level];
+            const size_type zeros_left = bits.rank0(left);
+            const size_type zeros_right = bits.rank0(right);
+            const size_type zeros = zeros_right - zeros_left;
+            if (k < zeros) {
+                left = zeros_left;
+                right = zeros_right;
+            } else {
+                k -= zeros;
+                result |= static_cast<value_type>(1) << (bits_count() - 1 - level);
+                left = zeros_count_[level] + (left - zeros_left);
+                right = zeros_count_[level] + (right - zeros_right);
+            }
+        }
+        return result;
+    }
+
+    value_type kth_largest(const size_type left, const size_type right, const size_type k) const {
+        return kth_smallest(left, right, right - left - 1 - k);
+    }
+
+    size_type count_less(size_type left, size_type right, const value_type upper) const
+    // elements of [left, right) less than upper
+    {
+        if (!fits(upper)) {
+            return right - left;
+        }
+        size_type result = 0;
+        for (size_type level = 0; level < bits_count(); ++level) {
+            const RankSelectBitvector& bits = levels_[level];
+            const size_type zeros_left = bits.rank0(left);
+            const size_type zeros_right = bits.rank0(right);
+            if (((upper >> (bits_count() - 1 - level)) & 1) != 0) {
+                result += zeros_right - zeros_left;
+                left = zeros_count_[level] + (left - zeros_left);
+                right = zeros_count_[level] + (right - zeros_right);
+            } else {
+                left = zeros_left;
+                right = zeros_right;
+            }
+        }
+        return result;
+    }
+
+    size_type range_freq(const size_type left, const size_type right, const value_type lower, const value_type upper) const
+    // elements of [left, right) with values in [lower, upper)
+    {
+        if (!(lower < upper)) {
+            return 0;
+        }
+        return count_less(left, right, upper) - count_less(left, right, lower);
+    }
+
+    bool prev_value(const size_type left, const size_type right, const value_type upper, value_type* result) const
+    // the largest value of [left, right) less than upper, false if there is none
+    {
+        const size_type count = count_less(left, right, upper);
+        if (count == 0) {
+            return false;
+        }
+        *result = kth_smallest(left, right, count - 1);
+        return true;
+    }
+
+    bool next_value(const size_type left, const size_type right, const value_type lower, value_type* result) const
+    // the smallest value of [left, right) not less than lower, false if there is none
+    {
+        const size_type count = count_less(left, right, lower);
+        if (count == right - left) {
+            return false;
+        }
+        *result = kth_smallest(left, right, count);
+        return true;
+    }
+
+private:
+    size_type size_ = 0;
+    std::vector<RankSelectBitvector> levels_;
+    std::vector<size_type> zeros_count_;
+
+    bool fits(const value_type value) const {
+        return bits_count() >= static_cast<size_type>(std::numeric_limits<value_type>::digits) || (value >> bits_count()) == 0;
+    }
+
+    void descend(const value_type value, size_type* left, size_type* right) const
+    // maps [left, right) of level 0 to the positions of its occurrences of value on the last level
+    {
+        for (size_type level = 0; level < bits_count(); ++level) {
+            const RankSelectBitvector& bits = levels_[level];
+            if (((value >> (bits_count() - 1 - level)) & 1) != 0) {
+                *left = zeros_count_[level] + bits.rank1(*left);
+                *right = zeros_count_[level] + bits.rank1(*right);
+            } else {
+                *left = bits.rank0(*left);
+                *right = bits.rank0(*right);
+            }
+        }
+    }
+};
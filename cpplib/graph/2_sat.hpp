@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <vector>
@@ -53,3 +54,205 @@ struct Solve2SAT {
         return result;
     }
 };
+
+class TwoSatSolver {
+// 2-SAT over variables 0..N-1, literal 2 * v means "v is true" and 2 * v + 1 means "v is false".
+// Implications are kept as an edge list and compressed into CSR for every solve, SCCs are found by iterative Tarjan.
+// Incremental: a clause satisfied by the last found assignment keeps it valid, so solve() reruns only when needed
+public:
+    using size_type = std::size_t;
+    using variable_type = std::size_t;
+    using literal_type = std::size_t;
+
+    explicit TwoSatSolver(const size_type variables_count = 0) :
+            assignment_(variables_count, false),
+            satisfiable_(true),
+            solved_(variables_count == 0)
+    {}
+
+    static constexpr literal_type positive(const variable_type variable) {
+        return variable << 1;
+    }
+
+    static constexpr literal_type negative(const variable_type variable) {
+        return (variable << 1) ^ 1;
+    }
+
+    static constexpr literal_type negation(const literal_type literal) {
+        return literal ^ 1;
+    }
+
+    [[nodiscard]] size_type variables_count() const {
+        return assignment_.size();
+    }
+
+    variable_type add_variable() {
+        assignment_.emplace_back(false);
+        return assignment_.size() - 1;
+    }
+
+    void add_or(const literal_type a, const literal_type b) {
+        from_.emplace_back(negation(a));
+        to_.emplace_back(b);
+        from_.emplace_back(negation(b));
+        to_.emplace_back(a);
+        if (solved_ && satisfiable_ && !is_true(a) && !is_true(b)) {
+            solved_ = false;
+        }
+    }
+
+    void add_implies(const literal_type a, const literal_type b) {
+        add_or(negation(a), b);
+    }
+
+    void add_xor(const literal_type a, const literal_type b) {
+        add_or(a, b);
+        add_or(negation(a), negation(b));
+    }
+
+    void add_equal(const literal_type a, const literal_type b) {
+        add_implies(a, b);
+        add_implies(b, a);
+    }
+
+    void set_value(const literal_type a) {
+        add_or(a, a);
+    }
+
+    void at_most_one(const std::vector<literal_type>& literals)
+    // sequential (prefix) encoding with O(k) auxiliary variables and clauses:
+    // prefix_i is true if any of the first i + 1 literals is true
+    {
+        if (literals.size() <= 1) {
+            return;
+        }
+        literal_type previous_prefix = positive(add_variable());
+        add_implies(literals[0], previous_prefix);
+        for (size_type i = 1; i < literals.size(); ++i) {
+            add_implies(previous_prefix, negation(literals[i]));
+            if (i + 1 == literals.size()) {
+                break;
+            }
+            const literal_type prefix = positive(add_variable());
+            add_implies(literals[i], prefix);
+            add_implies(previous_prefix, prefix);
+            previous_prefix = prefix;
+        }
+    }
+
+    bool solve()
+    // returns false if the formula has no solution
+    {
+        if (solved_ || !satisfiable_) {
+            return satisfiable_;
+        }
+        build_implications();
+        find_components();
+        satisfiable_ = true;
+        for (variable_type v = 0; v < variables_count(); ++v) {
+            const size_type true_component = component_[positive(v)];
+            const size_type false_component = component_[negative(v)];
+            if (true_component == false_component) {
+                satisfiable_ = false;
+                break;
+            }
+            // Tarjan numbers components in reversed topological order
+            assignment_[v] = (true_component < false_component);
+        }
+        solved_ = true;
+        return satisfiable_;
+    }
+
+    [[nodiscard]] const std::vector<bool>& assignment() const {
+        return assignment_;
+    }
+
+    [[nodiscard]] bool value(const variable_type variable) const {
+        return assignment_[variable];
+    }
+
+    [[nodiscard]] bool is_true(const literal_type literal) const {
+        return assignment_[literal >> 1] != static_cast<bool>(literal & 1);
+    }
+
+private:
+    static constexpr size_type kUndefined = std::numeric_limits<size_type>::max();
+
+    std::vector<literal_type> from_;
+    std::vector<literal_type> to_;
+    std::vector<bool> assignment_;
+    bool satisfiable_;
+    bool solved_;
+
+    std::vector<size_type> offsets_;
+    std::vector<literal_type> targets_;
+    std::vector<size_type> component_;
+    std::vector<size_type> order_;
+    std::vector<size_type> low_;
+    std::vector<size_type> pointer_;
+    std::vector<literal_type> stack_;
+    std::vector<literal_type> call_stack_;
+
+    void build_implications() {
+        const size_type literals_count = variables_count() << 1;
+        offsets_.assign(literals_count + 1, 0);
+        for (const literal_type from : from_) {
+            ++offsets_[from + 1];
+        }
+        for (size_type i = 0; i < literals_count; ++i) {
+            offsets_[i + 1] += offsets_[i];
+        }
+        targets_.resize(to_.size());
+        pointer_.assign(offsets_.begin(), offsets_.end() - 1);
+        for (size_type i = 0; i < from_.size(); ++i) {
+            targets_[pointer_[from_[i]]++] = to_[i];
+        }
+    }
+
+    void find_components() {
+        const size_type literals_count = variables_count() << 1;
+        component_.assign(literals_count, kUndefined);
+        order_.assign(literals_count, kUndefined);
+        low_.resize(literals_count);
+        pointer_.assign(offsets_.begin(), offsets_.end() - 1);
+        stack_.clear();
+        size_type timer = 0;
+        size_type components_count = 0;
+        for (literal_type root = 0; root < literals_count; ++root) {
+            if (order_[root] != kUndefined) {
+                continue;
+            }
+            call_stack_.assign(1, root);
+            order_[root] = low_[root] = timer++;
+            stack_.emplace_back(root);
+            while (!call_stack_.empty()) {
+                const literal_type v = call_stack_.back();
+                if (pointer_[v] < offsets_[v + 1]) {
+                    const literal_type to = targets_[pointer_[v]++];
+                    if (order_[to] == kUndefined) {
+                        order_[to] = low_[to] = timer++;
+                        stack_.emplace_back(to);
+                        call_stack_.emplace_back(to);
+                    } else if (component_[to] == kUndefined) {
+                        low_[v] = std::min(low_[v], order_[to]);
+                    }
+                    continue;
+                }
+                call_stack_.pop_back();
+                if (!call_stack_.empty()) {
+                    const literal_type parent = call_stack_.back();
+                    low_[parent] = std::min(low_[parent], low_[v]);
+                }
+                if (low_[v] == order_[v]) {
+                    literal_type u;
+                    do {
+                        u = stack_.back();
+                        stack_.pop_back();
+                        component_[u] = components_count;
+                    } while (u != v);
+                    ++components_count;
+                }
+            }
+        }
+    }
+};
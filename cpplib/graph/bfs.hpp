@@ -0,0 +1,223 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "graph.hpp"
+#include "base/parallel.hpp"
+#include "collections/dynamic_bitset.hpp"
+
+class BreadthFirstSearch {
+// direction-optimizing BFS (Beamer et al.): switches between top-down steps over a frontier queue
+// and bottom-up steps over a frontier bitset when the frontier covers a large part of the graph
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+
+    static constexpr size_type kUnreachable = std::numeric_limits<size_type>::max();
+    static constexpr vertex_id_type kUndefinedVertex = std::numeric_limits<vertex_id_type>::max();
+
+    // switch to bottom-up when frontier edges exceed unexplored_edges / kAlpha,
+    // back to top-down when frontier vertices drop below vertices_count / kBeta
+    static constexpr size_type kAlpha = 14;
+    static constexpr size_type kBeta = 24;
+
+    template<typename T, mask_type MASK>
+    explicit BreadthFirstSearch(const Graph<T, MASK>& graph, const bool parallel = false) :
+            outbound_(graph),
+            directed_(graph.is_directed()),
+            parallel_(parallel),
+            visited_(graph.vertices_count()),
+            frontier_bits_(graph.vertices_count()),
+            next_bits_(graph.vertices_count())
+    {
+        if (directed_) {
+            inbound_.build(graph, true);
+        }
+    }
+
+    void run(const vertex_id_type start_vertex);
+
+    [[nodiscard]] const std::vector<size_type>& distance() const {
+        return distance_;
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& parent() const {
+        return parent_;
+    }
+
+    [[nodiscard]] size_type distance(const vertex_id_type vertex) const {
+        return distance_[vertex];
+    }
+
+    [[nodiscard]] bool reachable(const vertex_id_type vertex) const {
+        return distance_[vertex] != kUnreachable;
+    }
+
+private:
+    CompressedGraph outbound_;
+    CompressedGraph inbound_;
+    bool directed_;
+    bool parallel_;
+
+    std::vector<size_type> distance_;
+    std::vector<vertex_id_type> parent_;
+
+    DynamicBitset visited_;
+    DynamicBitset frontier_bits_;
+    DynamicBitset next_bits_;
+    std::vector<vertex_id_type> frontier_;
+    std::vector<vertex_id_type> next_frontier_;
+    std::vector<std::vector<std::pair<vertex_id_type, vertex_id_type>>> candidates_;
+
+    [[nodiscard]] const CompressedGraph& inbound() const {
+        return directed_ ? inbound_ : outbound_;
+    }
+
+    void visit(const vertex_id_type vertex, const vertex_id_type parent, const size_type level) {
+        visited_.set(vertex);
+        distance_[vertex] = level;
+        parent_[vertex] = parent;
+    }
+
+    size_type top_down_step(size_type level);
+    size_type top_down_step_parallel(size_type level);
+    size_type bottom_up_step(size_type level);
+};
+
+inline void BreadthFirstSearch::run(const vertex_id_type start_vertex) {
+    const size_type vertices_count = outbound_.vertices_count();
+    distance_.assign(vertices_count, kUnreachable);
+    parent_.assign(vertices_count, kUndefinedVertex);
+    visited_.reset();
+    frontier_.clear();
+
+    visit(start_vertex, start_vertex, 0);
+    frontier_.emplace_back(start_vertex);
+    size_type frontier_size = 1;
+    size_type frontier_edges = outbound_.degree(start_vertex);
+    size_type unexplored_edges = outbound_.edges_count();
+    bool bottom_up = false;
+    for (size_type level = 1; frontier_size > 0; ++level) {
+        if (!bottom_up && frontier_edges > unexplored_edges / kAlpha) {
+            bottom_up = true;
+            frontier_bits_.reset();
+            for (const vertex_id_type v : frontier_) {
+                frontier_bits_.set(v);
+            }
+        } else if (bottom_up && frontier_size < vertices_count / kBeta) {
+            bottom_up = false;
+            frontier_.clear();
+            for (vertex_id_type v = frontier_bits_.least_significant_bit(); v < vertices_count; v = frontier_bits_.first_bit_after(v)) {
+                frontier_.emplace_back(v);
+            }
+        }
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+
+        if (bottom_up) {
+            frontier_edges = bottom_up_step(level);
+            frontier_size = frontier_bits_.count();
+        } else {
+            frontier_edges = (parallel_ ? top_down_step_parallel(level) : top_down_step(level));
+            frontier_size = frontier_.size();
+        }
+    }
+}
+
+inline BreadthFirstSearch::size_type BreadthFirstSearch::top_down_step(const size_type level)
+// returns the number of edges outgoing from the new frontier
+{
+    next_frontier_.clear();
+    size_type next_edges = 0;
+    for (const vertex_id_type v : frontier_) {
+        for (const vertex_id_type* it = outbound_.begin(v); it != outbound_.end(v); ++it) {
+            const vertex_id_type to = *it;
+            if (!visited_.get(to)) {
+                visit(to, v, level);
+                next_frontier_.emplace_back(to);
+                next_edges += outbound_.degree(to);
+            }
+        }
+    }
+    frontier_.swap(next_frontier_);
+    return next_edges;
+}
+
+inline BreadthFirstSearch::size_type BreadthFirstSearch::top_down_step_parallel(const size_type level)
+// edges are scanned concurrently against the read-only visited set, newly reached vertices
+// are collected into per-thread buffers and deduplicated in a sequential merge
+{
+    candidates_.resize(parallel_threads_count());
+    for (auto& buffer : candidates_) {
+        buffer.clear();
+    }
+    const size_type frontier_size = frontier_.size();
+    OMP_PRAGMA(omp parallel for schedule(dynamic, 64))
+    for (size_type i = 0; i < frontier_size; ++i) {
+        auto& buffer = candidates_[parallel_thread_id()];
+        const vertex_id_type v = frontier_[i];
+        for (const vertex_id_type* it = outbound_.begin(v); it != outbound_.end(v); ++it) {
+            if (!visited_.get(*it)) {
+                buffer.emplace_back(*it, v);
+            }
+        }
+    }
+
+    next_frontier_.clear();
+    size_type next_edges = 0;
+    for (const auto& buffer : candidates_) {
+        for (const auto& it : buffer) {
+            if (!visited_.get(it.first)) {
+                visit(it.first, it.second, level);
+                next_frontier_.emplace_back(it.first);
+                next_edges += outbound_.degree(it.first);
+            }
+        }
+    }
+    frontier_.swap(next_frontier_);
+    return next_edges;
+}
+
+inline BreadthFirstSearch::size_type BreadthFirstSearch::bottom_up_step(const size_type level)
+// every unvisited vertex looks for a parent in the frontier; work is split by 64-bit words,
+// so each thread owns its part of visited_ and next_bits_ and no synchronization is needed
+{
+    using value_type = DynamicBitset::value_type;
+
+    const CompressedGraph& inbound_graph = inbound();
+    const size_type vertices_count = outbound_.vertices_count();
+    const size_type words_count = visited_.words_count();
+    auto& visited = visited_.data();
+    auto& next = next_bits_.data();
+    size_type next_edges = 0;
+    OMP_PRAGMA(omp parallel for if(parallel_) schedule(dynamic, 16) reduction(+ : next_edges))
+    for (size_type word = 0; word < words_count; ++word) {
+        value_type unvisited = ~visited[word];
+        value_type awakened = 0;
+        while (unvisited != 0) {
+            const size_type bit = countr_zero(unvisited);
+            unvisited &= unvisited - 1;
+            const vertex_id_type v = (word << DynamicBitset::kIndexPower) + bit;
+            if (v >= vertices_count) {
+                break;
+            }
+            for (const vertex_id_type* it = inbound_graph.begin(v); it != inbound_graph.end(v); ++it) {
+                if (frontier_bits_.get(*it)) {
+                    distance_[v] = level;
+                    parent_[v] = *it;
+                    awakened |= static_cast<value_type>(1) << bit;
+                    next_edges += outbound_.degree(v);
+                    break;
+                }
+            }
+        }
+        next[word] = awakened;
+        visited[word] |= awakened;
+    }
+    frontier_bits_.swap(next_bits_);
+    return next_edges;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+
+class CompressedGraph {
+// CSR (compressed sparse row) view of Graph: adjacency of vertex v is stored
+// in targets()[offsets()[v]..offsets()[v + 1]), edge_ids() keeps the ids of the original edges
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using edge_id_type = std::size_t;
+
+    CompressedGraph() : offsets_(1, 0) {}
+
+    template<typename T, mask_type MASK>
+    explicit CompressedGraph(const Graph<T, MASK>& graph, const bool reversed = false) {
+        build(graph, reversed);
+    }
+
+    template<typename T, mask_type MASK>
+    void build(const Graph<T, MASK>& graph, const bool reversed = false)
+    // reversed = true stores inbound edges instead of outbound ones
+    {
+        const size_type vertices_count = graph.vertices_count();
+        const size_type edges_count = graph.edges_count();
+        offsets_.assign(vertices_count + 1, 0);
+        targets_.resize(edges_count);
+        edge_ids_.resize(edges_count);
+        if (!reversed) {
+            for (const vertex_id_type v : graph.vertices()) {
+                offsets_[v + 1] = offsets_[v] + graph.edges_list(v).size();
+                edge_id_type position = offsets_[v];
+                for (const edge_id_type id : graph.edges_list(v)) {
+                    targets_[position] = graph.to(id);
+                    edge_ids_[position] = id;
+                    ++position;
+                }
+            }
+            return;
+        }
+        for (edge_id_type id = 0; id < edges_count; ++id) {
+            ++offsets_[graph.to(id) + 1];
+        }
+        for (size_type v = 0; v < vertices_count; ++v) {
+            offsets_[v + 1] += offsets_[v];
+        }
+        std::vector<edge_id_type> position(offsets_.begin(), offsets_.end() - 1);
+        for (edge_id_type id = 0; id < edges_count; ++id) {
+            const edge_id_type index = position[graph.to(id)]++;
+            targets_[index] = graph.from(id);
+            edge_ids_[index] = id;
+        }
+    }
+
+    CompressedGraph& simplify()
+    // sorts every adjacency list and drops self-loops and parallel edges
+    {
+        std::vector<std::pair<vertex_id_type, edge_id_type>> adjacent;
+        edge_id_type position = 0;
+        edge_id_type start = 0;
+        for (vertex_id_type v = 0; v + 1 < offsets_.size(); ++v) {
+            const edge_id_type finish = offsets_[v + 1];
+            adjacent.clear();
+            for (edge_id_type i = start; i < finish; ++i) {
+                if (targets_[i] != v) {
+                    adjacent.emplace_back(targets_[i], edge_ids_[i]);
+                }
+            }
+            std::sort(adjacent.begin(), adjacent.end());
+            offsets_[v] = position;
+            for (size_type i = 0; i < adjacent.size(); ++i) {
+                if (i > 0 && adjacent[i].first == adjacent[i - 1].first) {
+                    continue;
+                }
+                targets_[position] = adjacent[i].first;
+                edge_ids_[position] = adjacent[i].second;
+                ++position;
+            }
+            start = finish;
+        }
+        offsets_.back() = position;
+        targets_.resize(position);
+        edge_ids_.resize(position);
+        return *this;
+    }
+
+    [[nodiscard]] size_type vertices_count() const {
+        return offsets_.size() - 1;
+    }
+
+    [[nodiscard]] size_type edges_count() const {
+        return targets_.size();
+    }
+
+    [[nodiscard]] size_type degree(const vertex_id_type vertex) const {
+        return offsets_[vertex + 1] - offsets_[vertex];
+    }
+
+    [[nodiscard]] const vertex_id_type* begin(const vertex_id_type vertex) const {
+        return targets_.data() + offsets_[vertex];
+    }
+
+    [[nodiscard]] const vertex_id_type* end(const vertex_id_type vertex) const {
+        return targets_.data() + offsets_[vertex + 1];
+    }
+
+    [[nodiscard]] const std::vector<edge_id_type>& offsets() const {
+        return offsets_;
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& targets() const {
+        return targets_;
+    }
+
+    [[nodiscard]] const std::vector<edge_id_type>& edge_ids() const {
+        return edge_ids_;
+    }
+
+private:
+    std::vector<edge_id_type> offsets_;
+    std::vector<vertex_id_type> targets_;
+    std::vector<edge_id_type> edge_ids_;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "graph.hpp"
+#include "base/parallel.hpp"
+
+struct ConnectedComponents {
+// labels every vertex with the minimal vertex id of its (weakly) connected component
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using edge_id_type = std::size_t;
+
+    template<typename T, mask_type MASK>
+    size_type operator()(const Graph<T, MASK>& graph, std::vector<vertex_id_type>* labels = nullptr, const bool parallel = false) const
+    // returns the number of connected components
+    {
+        std::vector<vertex_id_type> component(graph.vertices_count());
+        for (const vertex_id_type v : graph.vertices()) {
+            component[v] = v;
+        }
+        if (parallel) {
+            shiloach_vishkin(graph, component);
+        } else {
+            link_all(graph, component);
+        }
+
+        size_type components_count = 0;
+        for (const vertex_id_type v : graph.vertices()) {
+            if (component[v] == v) {
+                ++components_count;
+            }
+        }
+        if (labels != nullptr) {
+            labels->swap(component);
+        }
+        return components_count;
+    }
+
+private:
+    static vertex_id_type find_root(std::vector<vertex_id_type>& component, vertex_id_type vertex) {
+        while (component[vertex] != vertex) {
+            component[vertex] = component[component[vertex]];  // path halving
+            vertex = component[vertex];
+        }
+        return vertex;
+    }
+
+    template<typename T, mask_type MASK>
+    static void link_all(const Graph<T, MASK>& graph, std::vector<vertex_id_type>& component)
+    // union-find which always hangs the larger root under the smaller one, so roots are minimal ids
+    {
+        for (edge_id_type id = 0; id < graph.edges_count(); ++id) {
+            vertex_id_type x = find_root(component, graph.from(id));
+            vertex_id_type y = find_root(component, graph.to(id));
+            if (x == y) {
+                continue;
+            }
+            if (x < y) {
+                std::swap(x, y);
+            }
+            component[x] = y;
+        }
+        for (const vertex_id_type v : graph.vertices()) {
+            component[v] = component[component[v]];
+        }
+    }
+
+    template<typename T, mask_type MASK>
+    static void shiloach_vishkin(const Graph<T, MASK>& graph, std::vector<vertex_id_type>& component)
+    // alternates parallel hooking of roots onto smaller labels and pointer jumping until no hook happens;
+    // component[v] <= v holds all the time, so the final roots are the minimal ids of the components
+    {
+        const size_type vertices_count = graph.vertices_count();
+        const size_type edges_count = graph.edges_count();
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            OMP_PRAGMA(omp parallel for schedule(static) reduction(|| : changed))
+            for (edge_id_type id = 0; id < edges_count; ++id) {
+                vertex_id_type x;
+                vertex_id_type y;
+                OMP_PRAGMA(omp atomic read)
+                x = component[graph.from(id)];
+                OMP_PRAGMA(omp atomic read)
+                y = component[graph.to(id)];
+                if (x == y) {
+                    continue;
+                }
+                if (x < y) {
+                    std::swap(x, y);
+                }
+                vertex_id_type parent;
+                OMP_PRAGMA(omp atomic read)
+                parent = component[x];
+                if (parent == x) {
+                    OMP_PRAGMA(omp atomic write)
+                    component[x] = y;
+                    changed = true;
+                }
+            }
+
+            OMP_PRAGMA(omp parallel for schedule(static))
+            for (vertex_id_type v = 0; v < vertices_count; ++v) {
+                while (true) {
+                    vertex_id_type parent;
+                    vertex_id_type grandparent;
+                    OMP_PRAGMA(omp atomic read)
+                    parent = component[v];
+                    OMP_PRAGMA(omp atomic read)
+                    grandparent = component[parent];
+                    if (parent == grandparent) {
+                        break;
+                    }
+                    OMP_PRAGMA(omp atomic write)
+                    component[v] = grandparent;
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "directed_graph.hpp"
+
+class DominatorTree {
+// semi-NCA variant of Lengauer-Tarjan, O(E log V): semidominators are computed in reversed DFS preorder
+// by link-eval with path compression, then idom(v) is the nearest common ancestor of parent(v) and sdom(v).
+// All arrays are flat and indexed by DFS preorder number, DFS and path compression are iterative
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+
+    static constexpr vertex_id_type kUndefinedVertex = std::numeric_limits<vertex_id_type>::max();
+
+    template<typename T, mask_type MASK>
+    DominatorTree(const DirectedGraph<T, MASK>& graph, const vertex_id_type root) :
+            root_(root),
+            idom_(graph.vertices_count(), kUndefinedVertex),
+            number_(graph.vertices_count(), kUndefinedVertex)
+    {
+        dfs(graph);
+        compute(CompressedGraph(graph, true));
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& idom() const
+    // idom[root] = root, kUndefinedVertex for vertices unreachable from root
+    {
+        return idom_;
+    }
+
+    [[nodiscard]] vertex_id_type idom(const vertex_id_type vertex) const {
+        return idom_[vertex];
+    }
+
+    [[nodiscard]] bool reachable(const vertex_id_type vertex) const {
+        return number_[vertex] != kUndefinedVertex;
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& preorder() const
+    // reachable vertices in DFS preorder, every vertex comes after its immediate dominator
+    {
+        return vertex_;
+    }
+
+    template<typename T = int64_t>
+    [[nodiscard]] DirectedGraph<T> tree() const
+    // dominator tree with edges idom(v) -> v
+    {
+        DirectedGraph<T> result(idom_.size());
+        for (const vertex_id_type v : vertex_) {
+            if (v != root_) {
+                result.add_directed_edge(idom_[v], v);
+            }
+        }
+        return result;
+    }
+
+private:
+    vertex_id_type root_;
+    std::vector<vertex_id_type> idom_;
+    std::vector<size_type> number_;
+    std::vector<vertex_id_type> vertex_;
+
+    // indexed by preorder numbers
+    std::vector<size_type> parent_;
+    std::vector<size_type> semi_;
+    std::vector<size_type> label_;
+    std::vector<size_type> ancestor_;
+    std::vector<size_type> dominator_;
+    std::vector<size_type> path_;
+
+    template<typename T, mask_type MASK>
+    void dfs(const DirectedGraph<T, MASK>& graph) {
+        std::vector<size_type> pointer(graph.vertices_count(), 0);
+        std::vector<vertex_id_type> stack;
+        number_[root_] = 0;
+        vertex_.emplace_back(root_);
+        parent_.emplace_back(0);
+        stack.emplace_back(root_);
+        while (!stack.empty()) {
+            const vertex_id_type v = stack.back();
+            const auto& edges = graph.edges_list(v);
+            if (pointer[v] == edges.size()) {
+                stack.pop_back();
+                continue;
+            }
+            const vertex_id_type to = graph.to(edges[pointer[v]++]);
+            if (number_[to] == kUndefinedVertex) {
+                number_[to] = vertex_.size();
+                vertex_.emplace_back(to);
+                parent_.emplace_back(number_[v]);
+                stack.emplace_back(to);
+            }
+        }
+    }
+
+    size_type eval(const size_type v) {
+        if (ancestor_[v] == kUndefinedVertex) {
+            return v;
+        }
+        path_.clear();
+        for (size_type x = v; ancestor_[ancestor_[x]] != kUndefinedVertex; x = ancestor_[x]) {
+            path_.emplace_back(x);
+        }
+        for (auto it = path_.crbegin(); it != path_.crend(); ++it) {
+            const size_type x = *it;
+            const size_type a = ancestor_[x];
+            if (semi_[label_[a]] < semi_[label_[x]]) {
+                label_[x] = label_[a];
+            }
+            ancestor_[x] = ancestor_[a];
+        }
+        return label_[v];
+    }
+
+    void compute(const CompressedGraph& inbound) {
+        const size_type reachable_count = vertex_.size();
+        semi_.resize(reachable_count);
+        label_.resize(reachable_count);
+        dominator_.resize(reachable_count);
+        ancestor_.assign(reachable_count, kUndefinedVertex);
+        for (size_type i = 0; i < reachable_count; ++i) {
+            semi_[i] = i;
+            label_[i] = i;
+        }
+        for (size_type i = reachable_count; i-- > 1; ) {
+            const vertex_id_type w = vertex_[i];
+            for (const vertex_id_type* it = inbound.begin(w); it != inbound.end(w); ++it) {
+                const size_type v = number_[*it];
+                if (v == kUndefinedVertex) {
+                    continue;
+                }
+                const size_type u = eval(v);
+                if (semi_[u] < semi_[i]) {
+                    semi_[i] = semi_[u];
+                }
+            }
+            ancestor_[i] = parent_[i];
+        }
+        dominator_[0] = 0;
+        for (size_type i = 1; i < reachable_count; ++i) {
+            size_type d = parent_[i];
+            while (d > semi_[i]) {
+                d = dominator_[d];
+            }
+            dominator_[i] = d;
+        }
+        for (size_type i = 0; i < reachable_count; ++i) {
+            idom_[vertex_[i]] = vertex_[dominator_[i]];
+        }
+    }
+};
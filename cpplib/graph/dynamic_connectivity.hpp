@@ -0,0 +1,185 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "rollback_dsu.hpp"
+#include "hash/safe_integral_hash.hpp"
+#include "maths/bits.hpp"
+
+class OfflineDynamicConnectivity {
+// events are fed in log order, then solve() answers all queries in O((V + E + Q) log Q log V):
+// every edge lives on the interval of queries between its insertion and removal, the interval is split
+// into O(log Q) nodes of a segment tree over queries, and a DFS over the tree keeps the edges of the current
+// root-to-node path united in a DSU with rollback.
+// Parallel edges are counted: an edge disappears when every inserted copy of it is removed
+public:
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using query_id_type = std::size_t;
+
+    explicit OfflineDynamicConnectivity(const size_type vertices_count) :
+            vertices_count_(vertices_count)
+    {}
+
+    void add_edge(const vertex_id_type from, const vertex_id_type to) {
+        open_[key(from, to)].emplace_back(queries_.size());
+    }
+
+    bool remove_edge(const vertex_id_type from, const vertex_id_type to)
+    // returns false if there is no such edge at the moment
+    {
+        const auto it = open_.find(key(from, to));
+        if (it == open_.end() || it->second.empty()) {
+            return false;
+        }
+        intervals_.emplace_back(Interval{from, to, it->second.back(), queries_.size()});
+        it->second.pop_back();
+        return true;
+    }
+
+    query_id_type query_connected(const vertex_id_type from, const vertex_id_type to)
+    // is there a path between the vertices at this moment; returns the id of the query
+    {
+        queries_.emplace_back(Query{from, to});
+        return queries_.size() - 1;
+    }
+
+    query_id_type query_components_count()
+    // number of connected components at this moment; returns the id of the query
+    {
+        return query_connected(kUndefinedVertex, kUndefinedVertex);
+    }
+
+    [[nodiscard]] size_type queries_count() const {
+        return queries_.size();
+    }
+
+    void solve() {
+        const size_type queries_count = queries_.size();
+        answers_.assign(queries_count, 0);
+        if (queries_count == 0) {
+            return;
+        }
+        leaves_count_ = bit_ceil(queries_count);
+        // edges which are still present stay till the end of the log, more events may be added after solve()
+        std::vector<Interval> intervals(intervals_);
+        for (const auto& it : open_) {
+            for (const size_type start : it.second) {
+                intervals.emplace_back(Interval{it.first / vertices_count_, it.first % vertices_count_, start, queries_count});
+            }
+        }
+
+        node_offsets_.assign(2 * leaves_count_ + 1, 0);
+        split(intervals, true);
+        for (size_type node = 0; node < 2 * leaves_count_; ++node) {
+            node_offsets_[node + 1] += node_offsets_[node];
+        }
+        node_edges_.resize(node_offsets_.back());
+        split(intervals, false);
+        // storing moved every offset to the end of its node, shift them back
+        for (size_type node = 2 * leaves_count_; node > 0; --node) {
+            node_offsets_[node] = node_offsets_[node - 1];
+        }
+        node_offsets_[0] = 0;
+
+        dsu_.init(vertices_count_);
+        visit(1, 0);
+    }
+
+    [[nodiscard]] bool connected(const query_id_type query) const
+    // valid after solve()
+    {
+        return answers_[query] != 0;
+    }
+
+    [[nodiscard]] size_type components_count(const query_id_type query) const
+    // valid after solve()
+    {
+        return answers_[query];
+    }
+
+private:
+    static constexpr vertex_id_type kUndefinedVertex = std::numeric_limits<vertex_id_type>::max();
+
+    struct Interval {
+        vertex_id_type from;
+        vertex_id_type to;
+        // the edge is present for queries in [begin, end)
+        size_type begin;
+        size_type end;
+    };
+
+    struct Query {
+        vertex_id_type from;
+        vertex_id_type to;
+    };
+
+    size_type vertices_count_;
+    // start moments (number of earlier queries) of the inserted copies of every present edge
+    SafeUnorderedMap<uint64_t, std::vector<size_type>> open_;
+    // edges which are already removed
+    std::vector<Interval> intervals_;
+    std::vector<Query> queries_;
+    std::vector<size_type> answers_;
+
+    size_type leaves_count_ = 0;
+    // edges of the segment tree nodes in CSR form
+    std::vector<size_type> node_offsets_;
+    std::vector<std::pair<vertex_id_type, vertex_id_type>> node_edges_;
+    RollbackDSU dsu_;
+
+    uint64_t key(vertex_id_type from, vertex_id_type to) const {
+        if (from > to) {
+            std::swap(from, to);
+        }
+        return static_cast<uint64_t>(from) * vertices_count_ + to;
+    }
+
+    void split(const std::vector<Interval>& intervals, const bool count)
+    // bottom-up decomposition of every interval into tree nodes, either counting or storing the edges
+    {
+        for (const auto& interval : intervals) {
+            for (size_type l = interval.begin + leaves_count_, r = interval.end + leaves_count_; l < r; l >>= 1, r >>= 1) {
+                if ((l & 1) != 0) {
+                    push(l++, interval, count);
+                }
+                if ((r & 1) != 0) {
+                    push(--r, interval, count);
+                }
+            }
+        }
+    }
+
+    void push(const size_type node, const Interval& interval, const bool count) {
+        if (count) {
+            ++node_offsets_[node + 1];
+        } else {
+            node_edges_[node_offsets_[node]++] = std::make_pair(interval.from, interval.to);
+        }
+    }
+
+    void visit(const size_type node, const size_type first_leaf) {
+        const size_type snapshot = dsu_.snapshot();
+        for (size_type i = node_offsets_[node]; i < node_offsets_[node + 1]; ++i) {
+            dsu_.unite(node_edges_[i].first, node_edges_[i].second);
+        }
+        if (node >= leaves_count_) {
+            const Query& query = queries_[first_leaf];
+            if (query.from == kUndefinedVertex) {
+                answers_[first_leaf] = dsu_.sets_count();
+            } else {
+                answers_[first_leaf] = (dsu_.find_set(query.from) == dsu_.find_set(query.to) ? 1 : 0);
+            }
+        } else {
+            const size_type half = (leaves_count_ >> 1) >> (bit_width(node) - 1);
+            visit(2 * node, first_leaf);
+            if (first_leaf + half < queries_.size()) {
+                visit(2 * node + 1, first_leaf + half);
+            }
+        }
+        dsu_.rollback(snapshot);
+    }
+};
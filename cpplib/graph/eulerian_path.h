@@ -1,57 +1,56 @@
 #pragma once
 #include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "graph.hpp"
-#include "collections/stack/stack.hpp"
+#include "collections/dynamic_bitset.hpp"
 
-struct EulerianPath {
+class EulerianPath {
+// iterative Hierholzer algorithm; all buffers are members and are reused between calls.
+// Both copies of an undirected edge (ids 2k and 2k + 1) are marked used at once through the pair id k
+public:
     using mask_type = uint32_t;
     using vertex_id_type = std::size_t;
     using edge_id_type = std::size_t;
     using size_type = std::size_t;
 
+    static constexpr edge_id_type kFakeEdgeId = std::numeric_limits<edge_id_type>::max();
+
     template<typename T, mask_type MASK>
     bool operator()(
             const Graph<T, MASK>& graph,
             std::vector<edge_id_type>* eulerian_path = nullptr,
             const bool strict_cycle = false,
             const vertex_id_type starting_vertex = 0,
-            const bool strict_starting_vertex = false) const {
-        using graph_type = Graph<T, MASK>;
-
-        const size_type vertices_count = graph.vertices_count();
+            const bool strict_starting_vertex = false)
+    // returns false if there is no eulerian path (or cycle if strict_cycle = true) covering all edges
+    {
         const size_type edges_count = graph.edges_count();
-        const bool is_directed = graph.is_directed();
-
-        const size_type real_edges_count = edges_count / (is_directed ? 1 : 2);
+        directed_ = graph.is_directed();
+        const size_type real_edges_count = edges_count / (directed_ ? 1 : 2);
         if (real_edges_count == 0) {
             if (eulerian_path != nullptr) {
                 eulerian_path->clear();
             }
             return true;
         }
-        std::vector<size_type> inbound_degree(vertices_count, 0);
-        std::vector<size_type> outbound_degree(vertices_count, 0);
-        for (const auto& it : graph.edges()) {
-            ++outbound_degree[it.from()];
-            if (is_directed) {
-                ++inbound_degree[it.to()];  // in undirected graph_ all edges_ are duplicated: forward and backward
-            }
-        }
-        std::vector<vertex_id_type> odd_degree_vertices;
+        count_degrees(graph);
+
+        odd_vertices_.clear();
         for (const vertex_id_type v : graph.vertices()) {
-            if ((inbound_degree[v] + outbound_degree[v]) % 2 == 1) {
-                odd_degree_vertices.emplace_back(v);
+            if ((inbound_degree_[v] + outbound_degree_[v]) % 2 == 1) {
+                odd_vertices_.emplace_back(v);
             }
         }
-        if (is_directed) {
-            int32_t min_diff = 0;
-            int32_t max_diff = 0;
+        if (directed_) {
+            int64_t min_diff = 0;
+            int64_t max_diff = 0;
             size_type not_equal_degree_vertices_count = 0;
             for (const vertex_id_type v : graph.vertices()) {
-                const int32_t diff = static_cast<int32_t>(outbound_degree[v]) - inbound_degree[v];
+                const int64_t diff = static_cast<int64_t>(outbound_degree_[v]) - static_cast<int64_t>(inbound_degree_[v]);
                 if (diff != 0) {
                     ++not_equal_degree_vertices_count;
                     min_diff = std::min(min_diff, diff);
@@ -63,83 +62,243 @@ struct EulerianPath {
             }
         }
         vertex_id_type root = starting_vertex;
-        if (!odd_degree_vertices.empty()) {
-            if (odd_degree_vertices.size() > 2 || strict_cycle) {
+        if (!odd_vertices_.empty()) {
+            if (odd_vertices_.size() > 2 || strict_cycle) {
                 return false;
             }
-            const bool starting_vertex_has_odd_degree = (std::find(odd_degree_vertices.cbegin(), odd_degree_vertices.cend(), starting_vertex) != odd_degree_vertices.cend());
-            if (!starting_vertex_has_odd_degree || outbound_degree[starting_vertex] < inbound_degree[starting_vertex]) {
+            const bool starting_vertex_has_odd_degree = (std::find(odd_vertices_.cbegin(), odd_vertices_.cend(), starting_vertex) != odd_vertices_.cend());
+            if (!starting_vertex_has_odd_degree || outbound_degree_[starting_vertex] < inbound_degree_[starting_vertex]) {
                 if (strict_starting_vertex) {
                     return false;
                 }
-                for (const vertex_id_type v : odd_degree_vertices) {
-                    if (outbound_degree[v] > inbound_degree[v]) {
+                for (const vertex_id_type v : odd_vertices_) {
+                    if (outbound_degree_[v] > inbound_degree_[v]) {
                         root = v;
                         break;
                     }
                 }
             }
         }
-        else if (outbound_degree[root] == 0) {
+        else if (outbound_degree_[root] == 0) {
             if (strict_starting_vertex) {
                 return false;
             }
             for (const vertex_id_type v : graph.vertices()) {
-                if (outbound_degree[v] > 0) {
+                if (outbound_degree_[v] > 0) {
                     root = v;
+                    break;
                 }
             }
         }
 
-        std::vector<bool> used_edge(edges_count, false);
-        auto mark_used = [&used_edge, &is_directed](const edge_id_type edge_id) {
-            used_edge[edge_id] = true;
-            if (!is_directed) {
-                used_edge[edge_id ^ 1] = true;  // mark reversed edge as directed
+        virtual_from_.clear();
+        virtual_to_.clear();
+        build_adjacency(graph);
+        result_.clear();
+        walk(root, result_);
+        if (result_.size() != real_edges_count) {
+            return false;
+        }
+        if (eulerian_path != nullptr) {
+            eulerian_path->assign(result_.crbegin(), result_.crend());
+        }
+        return true;
+    }
+
+    template<typename T, mask_type MASK>
+    size_type decompose(const Graph<T, MASK>& graph, std::vector<std::vector<edge_id_type>>* trails = nullptr)
+    // splits all edges (the graph may be disconnected) into the minimal number of trails:
+    // every component with all degrees balanced gives a cycle, otherwise vertices with unbalanced degrees
+    // are paired by virtual edges, eulerian cycles of the augmented graph are cut at them into paths
+    // returns the number of trails
+    {
+        directed_ = graph.is_directed();
+        count_degrees(graph);
+
+        virtual_from_.clear();
+        virtual_to_.clear();
+        if (directed_) {
+            odd_vertices_.clear();
+            for (const vertex_id_type v : graph.vertices()) {
+                for (size_type i = outbound_degree_[v]; i < inbound_degree_[v]; ++i) {
+                    odd_vertices_.emplace_back(v);
+                }
             }
-        };
+            size_type index = 0;
+            for (const vertex_id_type v : graph.vertices()) {
+                for (size_type i = inbound_degree_[v]; i < outbound_degree_[v]; ++i) {
+                    virtual_from_.emplace_back(odd_vertices_[index++]);
+                    virtual_to_.emplace_back(v);
+                }
+            }
+        } else {
+            vertex_id_type previous = kUndefinedVertex;
+            for (const vertex_id_type v : graph.vertices()) {
+                if (outbound_degree_[v] % 2 == 0) {
+                    continue;
+                }
+                if (previous == kUndefinedVertex) {
+                    previous = v;
+                } else {
+                    virtual_from_.emplace_back(previous);
+                    virtual_to_.emplace_back(v);
+                    previous = kUndefinedVertex;
+                }
+            }
+        }
+        build_adjacency(graph);
 
-        std::vector<typename graph_type::EdgesList::const_iterator> current_edge_pointer(vertices_count);
+        const edge_id_type first_virtual_edge = graph.edges_count();
+        size_type trails_count = 0;
+        if (trails != nullptr) {
+            trails->clear();
+        }
         for (const vertex_id_type v : graph.vertices()) {
-            current_edge_pointer[v] = graph.edges_list(v).cbegin();
-        }
-        const edge_id_type kFakeEdgeId = std::numeric_limits<edge_id_type>::max();
-        const size_type max_edges_count = real_edges_count + 1;  // add fake edge
-        Stack<std::pair<vertex_id_type, edge_id_type>> stack(max_edges_count);
-        stack.push({root, kFakeEdgeId});
-
-        std::vector<edge_id_type> result;
-        result.reserve(max_edges_count);
-        while (!stack.empty()) {
-            vertex_id_type v;
-            edge_id_type last_edge_id;
-            std::tie(v, last_edge_id) = stack.top();
-
-            auto& iterator = current_edge_pointer[v];
-            if (iterator == graph.edges_list(v).cend()) {
-                result.emplace_back(last_edge_id);
-                stack.pop();
+            result_.clear();
+            walk(v, result_);
+            if (result_.empty()) {
                 continue;
             }
-
-            const edge_id_type next_edge_id = *iterator++;
-            if (used_edge[next_edge_id]) {
+            std::reverse(result_.begin(), result_.end());
+            const auto first_virtual = std::find_if(result_.cbegin(), result_.cend(), [first_virtual_edge](const edge_id_type id) {
+                return id >= first_virtual_edge;
+            });
+            if (first_virtual == result_.cend()) {
+                ++trails_count;
+                if (trails != nullptr) {
+                    trails->emplace_back(result_);
+                }
                 continue;
             }
-            mark_used(next_edge_id);
-            stack.push({graph.to(next_edge_id), next_edge_id});
+            // the walk is closed, so it can be rotated to start right after a virtual edge
+            std::rotate(result_.begin(), result_.begin() + (first_virtual - result_.cbegin()) + 1, result_.end());
+            auto trail_begin = result_.cbegin();
+            for (auto it = result_.cbegin(); it != result_.cend(); ++it) {
+                if (*it < first_virtual_edge) {
+                    continue;
+                }
+                if (trail_begin != it) {
+                    ++trails_count;
+                    if (trails != nullptr) {
+                        trails->emplace_back(trail_begin, it);
+                    }
+                }
+                trail_begin = it + 1;
+            }
+        }
+        return trails_count;
+    }
+
+private:
+    static constexpr vertex_id_type kUndefinedVertex = std::numeric_limits<vertex_id_type>::max();
+
+    bool directed_ = true;
+    std::vector<size_type> inbound_degree_;
+    std::vector<size_type> outbound_degree_;
+    std::vector<vertex_id_type> odd_vertices_;
+    std::vector<vertex_id_type> virtual_from_;
+    std::vector<vertex_id_type> virtual_to_;
+
+    // adjacency of real and virtual edges in CSR form, virtual edges get ids starting from graph.edges_count()
+    std::vector<size_type> offsets_;
+    std::vector<edge_id_type> adjacent_edge_;
+    std::vector<vertex_id_type> adjacent_vertex_;
+    std::vector<size_type> pointer_;
+    DynamicBitset used_;
+
+    std::vector<std::pair<vertex_id_type, edge_id_type>> stack_;
+    std::vector<edge_id_type> result_;
+
+    edge_id_type pair_id(const edge_id_type id) const {
+        return directed_ ? id : (id >> 1);
+    }
+
+    template<typename T, mask_type MASK>
+    void count_degrees(const Graph<T, MASK>& graph)
+    // for undirected graphs inbound degrees stay zero, outbound ones count both directions
+    {
+        const size_type vertices_count = graph.vertices_count();
+        inbound_degree_.assign(vertices_count, 0);
+        outbound_degree_.resize(vertices_count);
+        for (const vertex_id_type v : graph.vertices()) {
+            outbound_degree_[v] = graph.edges_list(v).size();
+        }
+        if (directed_) {
+            for (edge_id_type id = 0; id < graph.edges_count(); ++id) {
+                ++inbound_degree_[graph.to(id)];
+            }
+        }
+    }
+
+    template<typename T, mask_type MASK>
+    void build_adjacency(const Graph<T, MASK>& graph) {
+        const size_type vertices_count = graph.vertices_count();
+        const edge_id_type edges_count = graph.edges_count();
+        const size_type virtual_count = virtual_from_.size();
+
+        offsets_.assign(vertices_count + 1, 0);
+        for (const vertex_id_type v : graph.vertices()) {
+            offsets_[v + 1] = graph.edges_list(v).size();
+        }
+        for (size_type i = 0; i < virtual_count; ++i) {
+            ++offsets_[virtual_from_[i] + 1];
+            if (!directed_) {
+                ++offsets_[virtual_to_[i] + 1];
+            }
         }
-        if (!result.empty() && result.back() == kFakeEdgeId) {
-            result.pop_back();
+        for (size_type v = 0; v < vertices_count; ++v) {
+            offsets_[v + 1] += offsets_[v];
         }
-        if (result.size() != real_edges_count) {
-            return false;
+        adjacent_edge_.resize(offsets_.back());
+        adjacent_vertex_.resize(offsets_.back());
+        pointer_.assign(offsets_.begin(), offsets_.end() - 1);
+        for (const vertex_id_type v : graph.vertices()) {
+            for (const edge_id_type id : graph.edges_list(v)) {
+                adjacent_edge_[pointer_[v]] = id;
+                adjacent_vertex_[pointer_[v]] = graph.to(id);
+                ++pointer_[v];
+            }
         }
+        for (size_type i = 0; i < virtual_count; ++i) {
+            const vertex_id_type from = virtual_from_[i];
+            const vertex_id_type to = virtual_to_[i];
+            if (directed_) {
+                adjacent_edge_[pointer_[from]] = edges_count + i;
+                adjacent_vertex_[pointer_[from]++] = to;
+            } else {
+                adjacent_edge_[pointer_[from]] = edges_count + 2 * i;
+                adjacent_vertex_[pointer_[from]++] = to;
+                adjacent_edge_[pointer_[to]] = edges_count + 2 * i + 1;
+                adjacent_vertex_[pointer_[to]++] = from;
+            }
+        }
+        pointer_.assign(offsets_.begin(), offsets_.end() - 1);
+        used_.init(pair_id(offsets_.back() + 1));
+    }
 
-        if (eulerian_path != nullptr) {
-            std::reverse(result.begin(), result.end());
-            eulerian_path->swap(result);
+    void walk(const vertex_id_type root, std::vector<edge_id_type>& result)
+    // appends the edges of the trail starting at root in reversed order
+    {
+        stack_.clear();
+        stack_.emplace_back(root, kFakeEdgeId);
+        while (!stack_.empty()) {
+            const vertex_id_type v = stack_.back().first;
+            size_type& pointer = pointer_[v];
+            const size_type finish = offsets_[v + 1];
+            while (pointer < finish && used_.get(pair_id(adjacent_edge_[pointer]))) {
+                ++pointer;
+            }
+            if (pointer == finish) {
+                if (stack_.back().second != kFakeEdgeId) {
+                    result.emplace_back(stack_.back().second);
+                }
+                stack_.pop_back();
+                continue;
+            }
+            const edge_id_type id = adjacent_edge_[pointer];
+            used_.set(pair_id(id));
+            stack_.emplace_back(adjacent_vertex_[pointer], id);
+            ++pointer;
         }
-        return true;
     }
 };
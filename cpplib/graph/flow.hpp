@@ -66,6 +66,24 @@ public:
         return edges_.size();
     }
 
+    [[nodiscard]] size_type vertices_count() const {
+        return graph_.size();
+    }
+
+    void reset_flow()
+    // makes the network reusable for another find_flow() call without rebuilding it
+    {
+        for (auto& edge : edges_) {
+            edge.flow = 0;
+        }
+    }
+
+    [[nodiscard]] bool is_source_side(const vertex_id_type vertex) const
+    // valid after find_flow(): true if the vertex is on the source side of the found minimal cut
+    {
+        return used_[vertex];
+    }
+
 private:
     void push_edge(const vertex_id_type from, const vertex_id_type to, const weight_type capacity, const weight_type backward_capacity) {
         graph_[from].emplace_back(edges_.size());
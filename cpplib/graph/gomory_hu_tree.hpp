@@ -0,0 +1,159 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "flow.hpp"
+#include "base/parallel.hpp"
+
+template<typename T>
+class GomoryHuTree {
+// Gusfield's equivalent flow tree: min cut between u and v equals the minimal edge weight on the tree path,
+// built with V - 1 max flow computations on one network (flows are reset between them),
+// path minimums are answered in O(log V) by binary lifting.
+// Network should be undirected: every edge added as add_bidirectional_edge(u, v, c, c)
+public:
+    using weight_type = T;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using network_type = DinicFlow<weight_type>;
+
+    explicit GomoryHuTree(const network_type& network, const bool parallel = false) :
+            vertices_count_(network.vertices_count()),
+            parent_(vertices_count_, 0),
+            weight_(vertices_count_, network_type::weight_infinity())
+    {
+        if (parallel && parallel_threads_count() > 1) {
+            build_parallel(network);
+        } else {
+            build(network);
+        }
+        build_lifting();
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& parent() const
+    // tree is rooted at vertex 0, parent[v] < v for every other vertex
+    {
+        return parent_;
+    }
+
+    [[nodiscard]] const std::vector<weight_type>& weight() const
+    // weight[v] is the weight of the tree edge (v, parent[v])
+    {
+        return weight_;
+    }
+
+    [[nodiscard]] weight_type min_cut(vertex_id_type u, vertex_id_type v) const
+    // returns weight_infinity() for u = v
+    {
+        weight_type result = network_type::weight_infinity();
+        if (depth_[u] < depth_[v]) {
+            std::swap(u, v);
+        }
+        for (size_type level = 0, diff = depth_[u] - depth_[v]; diff > 0; ++level, diff >>= 1) {
+            if ((diff & 1) != 0) {
+                result = std::min(result, min_[level * vertices_count_ + u]);
+                u = up_[level * vertices_count_ + u];
+            }
+        }
+        if (u == v) {
+            return result;
+        }
+        for (size_type level = levels_count_; level-- > 0; ) {
+            const size_type index = level * vertices_count_;
+            if (up_[index + u] != up_[index + v]) {
+                result = std::min(result, std::min(min_[index + u], min_[index + v]));
+                u = up_[index + u];
+                v = up_[index + v];
+            }
+        }
+        return std::min(result, std::min(weight_[u], weight_[v]));
+    }
+
+private:
+    size_type vertices_count_;
+    std::vector<vertex_id_type> parent_;
+    std::vector<weight_type> weight_;
+
+    size_type levels_count_ = 0;
+    std::vector<size_type> depth_;
+    std::vector<vertex_id_type> up_;
+    std::vector<weight_type> min_;
+
+    void apply_cut(const vertex_id_type s, const vertex_id_type t, const weight_type flow, const std::vector<bool>& source_side) {
+        weight_[s] = flow;
+        for (vertex_id_type v = s + 1; v < vertices_count_; ++v) {
+            if (parent_[v] == t && source_side[v]) {
+                parent_[v] = s;
+            }
+        }
+    }
+
+    void build(const network_type& initial_network) {
+        network_type network = initial_network;
+        std::vector<bool> source_side(vertices_count_);
+        for (vertex_id_type s = 1; s < vertices_count_; ++s) {
+            network.reset_flow();
+            const weight_type flow = network.find_flow(s, parent_[s]);
+            for (vertex_id_type v = 0; v < vertices_count_; ++v) {
+                source_side[v] = network.is_source_side(v);
+            }
+            apply_cut(s, parent_[s], flow, source_side);
+        }
+    }
+
+    void build_parallel(const network_type& initial_network)
+    // speculative batches: flows for the next vertices are computed concurrently on cloned networks
+    // with the current parents, then results are applied in order while the parents they used are still valid;
+    // the first invalidated vertex starts the next batch, so the tree is the same as the sequential one
+    {
+        const size_type threads_count = parallel_threads_count();
+        std::vector<network_type> networks(threads_count, initial_network);
+        std::vector<vertex_id_type> sink(threads_count);
+        std::vector<weight_type> flow(threads_count);
+        std::vector<std::vector<bool>> source_side(threads_count, std::vector<bool>(vertices_count_));
+        vertex_id_type s = 1;
+        while (s < vertices_count_) {
+            const size_type batch_size = std::min(threads_count, vertices_count_ - s);
+            for (size_type i = 0; i < batch_size; ++i) {
+                sink[i] = parent_[s + i];
+            }
+            OMP_PRAGMA(omp parallel for schedule(static, 1))
+            for (size_type i = 0; i < batch_size; ++i) {
+                network_type& network = networks[i];
+                network.reset_flow();
+                flow[i] = network.find_flow(s + i, sink[i]);
+                for (vertex_id_type v = 0; v < vertices_count_; ++v) {
+                    source_side[i][v] = network.is_source_side(v);
+                }
+            }
+            for (size_type i = 0; i < batch_size && parent_[s] == sink[i]; ++i, ++s) {
+                apply_cut(s, sink[i], flow[i], source_side[i]);
+            }
+        }
+    }
+
+    void build_lifting() {
+        levels_count_ = 1;
+        while ((static_cast<size_type>(1) << levels_count_) < vertices_count_) {
+            ++levels_count_;
+        }
+        depth_.assign(vertices_count_, 0);
+        up_.assign(levels_count_ * vertices_count_, 0);
+        min_.assign(levels_count_ * vertices_count_, network_type::weight_infinity());
+        for (vertex_id_type v = 1; v < vertices_count_; ++v) {
+            depth_[v] = depth_[parent_[v]] + 1;
+            up_[v] = parent_[v];
+            min_[v] = weight_[v];
+        }
+        for (size_type level = 1; level < levels_count_; ++level) {
+            const size_type index = level * vertices_count_;
+            const size_type previous = index - vertices_count_;
+            for (vertex_id_type v = 0; v < vertices_count_; ++v) {
+                const vertex_id_type middle = up_[previous + v];
+                up_[index + v] = up_[previous + middle];
+                min_[index + v] = std::min(min_[previous + v], min_[previous + middle]);
+            }
+        }
+    }
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "graph.hpp"
+#include "collections/dynamic_bitset.hpp"
+#include "maths/bits.hpp"
+
+class DsaturColoring {
+// Brelaz heuristic: the next vertex is the uncolored one with the most distinct colors among its neighbours
+// (ties are broken by the degree in the uncolored subgraph), it gets the smallest color not used by them.
+// Adjacency rows and sets of neighbour colors are bitsets, so a step costs O(V / 64) words plus the scan, O(V^2) total.
+// For directed graphs an edge in either direction makes two vertices adjacent, self-loops are ignored
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using edge_id_type = std::size_t;
+    using value_type = DynamicBitset::value_type;
+
+    template<typename T, mask_type MASK>
+    size_type operator()(const Graph<T, MASK>& graph, std::vector<size_type>* vertex_color = nullptr)
+    // returns the number of used colors, colors are numbered from 0
+    {
+        const size_type vertices_count = graph.vertices_count();
+        const size_type words_count = DynamicBitset::words_count(vertices_count);
+        adjacency_.assign(vertices_count, DynamicBitset(vertices_count));
+        for (const vertex_id_type v : graph.vertices()) {
+            for (const edge_id_type id : graph.edges_list(v)) {
+                const vertex_id_type to = graph.to(id);
+                if (to != v) {
+                    adjacency_[v].set(to);
+                    adjacency_[to].set(v);
+                }
+            }
+        }
+        neighbour_colors_.assign(vertices_count, DynamicBitset(vertices_count));
+        saturation_.assign(vertices_count, 0);
+        degree_.resize(vertices_count);
+        for (vertex_id_type v = 0; v < vertices_count; ++v) {
+            degree_[v] = adjacency_[v].count();
+        }
+        uncolored_.init(vertices_count);
+        uncolored_.set();
+        color_.assign(vertices_count, kUncolored);
+
+        size_type colors_count = 0;
+        for (size_type step = 0; step < vertices_count; ++step) {
+            vertex_id_type chosen = uncolored_.least_significant_bit();
+            for (vertex_id_type v = uncolored_.first_bit_after(chosen); v < vertices_count; v = uncolored_.first_bit_after(v)) {
+                if (saturation_[v] > saturation_[chosen] || (saturation_[v] == saturation_[chosen] && degree_[v] > degree_[chosen])) {
+                    chosen = v;
+                }
+            }
+            const size_type color = first_free_color(neighbour_colors_[chosen]);
+            color_[chosen] = color;
+            colors_count = std::max(colors_count, color + 1);
+            uncolored_.clear(chosen);
+
+            const value_type* row = adjacency_[chosen].data().data();
+            const value_type* uncolored = uncolored_.data().data();
+            for (size_type word = 0; word < words_count; ++word) {
+                for (value_type bits = row[word] & uncolored[word]; bits != 0; bits &= bits - 1) {
+                    const vertex_id_type u = (word << DynamicBitset::kIndexPower) + countr_zero(bits);
+                    --degree_[u];
+                    if (!neighbour_colors_[u].get(color)) {
+                        neighbour_colors_[u].set(color);
+                        ++saturation_[u];
+                    }
+                }
+            }
+        }
+        if (vertex_color != nullptr) {
+            *vertex_color = color_;
+        }
+        return colors_count;
+    }
+
+private:
+    static constexpr size_type kUncolored = std::numeric_limits<size_type>::max();
+
+    std::vector<DynamicBitset> adjacency_;
+    std::vector<DynamicBitset> neighbour_colors_;
+    std::vector<size_type> saturation_;
+    std::vector<size_type> degree_;
+    std::vector<size_type> color_;
+    DynamicBitset uncolored_;
+
+    static size_type first_free_color(const DynamicBitset& used) {
+        const auto& data = used.data();
+        for (size_type word = 0; word < data.size(); ++word) {
+            if (~data[word] != 0) {
+                return (word << DynamicBitset::kIndexPower) + countr_zero(~data[word]);
+            }
+        }
+        // not reachable: a vertex has less than V neighbours, so one of V colors is free
+        return used.size();
+    }
+};
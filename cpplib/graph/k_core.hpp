@@ -0,0 +1,139 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "undirected_graph.hpp"
+#include "base/parallel.hpp"
+
+struct CoreDecomposition {
+// core number of every vertex of the simple graph underlying UndirectedGraph
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+
+    template<typename T, mask_type MASK>
+    size_type operator()(const UndirectedGraph<T, MASK>& graph, std::vector<size_type>* core_number = nullptr, const bool parallel = false) const
+    // returns the degeneracy of the graph (maximal core number)
+    {
+        CompressedGraph adjacency(graph);
+        adjacency.simplify();
+        std::vector<size_type> core(graph.vertices_count());
+        for (const vertex_id_type v : graph.vertices()) {
+            core[v] = adjacency.degree(v);
+        }
+        if (parallel) {
+            peel_levels(adjacency, core);
+        } else {
+            peel_buckets(adjacency, core);
+        }
+        const size_type degeneracy = (core.empty() ? 0 : *std::max_element(core.cbegin(), core.cend()));
+        if (core_number != nullptr) {
+            core_number->swap(core);
+        }
+        return degeneracy;
+    }
+
+private:
+    static void peel_buckets(const CompressedGraph& adjacency, std::vector<size_type>& degree)
+    // Batagelj-Zaversnik O(V + E): vertices are kept sorted by current degree, the minimal one is removed each step
+    {
+        const size_type vertices_count = degree.size();
+        const size_type max_degree = (degree.empty() ? 0 : *std::max_element(degree.cbegin(), degree.cend()));
+        std::vector<size_type> bucket_start(max_degree + 2, 0);
+        for (const size_type d : degree) {
+            ++bucket_start[d + 1];
+        }
+        for (size_type d = 0; d <= max_degree; ++d) {
+            bucket_start[d + 1] += bucket_start[d];
+        }
+        std::vector<vertex_id_type> sorted(vertices_count);
+        std::vector<size_type> position(vertices_count);
+        {
+            std::vector<size_type> next(bucket_start.begin(), bucket_start.end() - 1);
+            for (vertex_id_type v = 0; v < vertices_count; ++v) {
+                position[v] = next[degree[v]]++;
+                sorted[position[v]] = v;
+            }
+        }
+        for (size_type i = 0; i < vertices_count; ++i) {
+            const vertex_id_type v = sorted[i];
+            for (const vertex_id_type* it = adjacency.begin(v); it != adjacency.end(v); ++it) {
+                const vertex_id_type u = *it;
+                if (degree[u] <= degree[v]) {
+                    continue;
+                }
+                // move u to the front of its bucket and shrink the bucket
+                const size_type d = degree[u];
+                const size_type front = bucket_start[d];
+                const vertex_id_type w = sorted[front];
+                std::swap(sorted[front], sorted[position[u]]);
+                position[w] = position[u];
+                position[u] = front;
+                ++bucket_start[d];
+                --degree[u];
+            }
+        }
+    }
+
+    static void peel_levels(const CompressedGraph& adjacency, std::vector<size_type>& degree)
+    // level-synchronous peeling: all vertices of the current k-shell are removed in parallel,
+    // neighbours that drop to k join the next round of the same level
+    {
+        const size_type vertices_count = degree.size();
+        std::vector<bool> removed(vertices_count, false);
+        std::vector<vertex_id_type> remaining(vertices_count);
+        for (vertex_id_type v = 0; v < vertices_count; ++v) {
+            remaining[v] = v;
+        }
+        std::vector<std::vector<vertex_id_type>> buffers(parallel_threads_count());
+        std::vector<vertex_id_type> frontier;
+        while (!remaining.empty()) {
+            size_type level = degree[remaining.front()];
+            for (const vertex_id_type v : remaining) {
+                level = std::min(level, degree[v]);
+            }
+            frontier.clear();
+            for (const vertex_id_type v : remaining) {
+                if (degree[v] == level) {
+                    frontier.emplace_back(v);
+                }
+            }
+            while (!frontier.empty()) {
+                for (const vertex_id_type v : frontier) {
+                    removed[v] = true;
+                }
+                const size_type frontier_size = frontier.size();
+                OMP_PRAGMA(omp parallel for schedule(dynamic, 64))
+                for (size_type i = 0; i < frontier_size; ++i) {
+                    auto& buffer = buffers[parallel_thread_id()];
+                    const vertex_id_type v = frontier[i];
+                    for (const vertex_id_type* it = adjacency.begin(v); it != adjacency.end(v); ++it) {
+                        const vertex_id_type u = *it;
+                        if (removed[u]) {
+                            continue;
+                        }
+                        size_type old_degree;
+                        OMP_PRAGMA(omp atomic capture)
+                        old_degree = degree[u]--;
+                        if (old_degree == level + 1) {
+                            buffer.emplace_back(u);
+                        } else if (old_degree <= level) {
+                            OMP_PRAGMA(omp atomic)
+                            ++degree[u];
+                        }
+                    }
+                }
+                frontier.clear();
+                for (auto& buffer : buffers) {
+                    frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+                    buffer.clear();
+                }
+            }
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&removed](const vertex_id_type v) {
+                return removed[v];
+            }), remaining.end());
+        }
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "graph.hpp"
+#include "collections/dynamic_bitset.hpp"
+#include "maths/bits.hpp"
+
+class MaximumClique {
+// exact branch and bound over bitset adjacency rows (Tomita MCQ with San Segundo's bitset colouring):
+// candidates are greedily split into colour classes, a vertex of colour k can extend the current clique
+// by at most k vertices, so branches with |clique| + k <= |best| are cut.
+// Vertices are renumbered in degeneracy order, the densest core gets the smallest indices.
+// For directed graphs an edge in either direction makes two vertices adjacent, self-loops are ignored
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using edge_id_type = std::size_t;
+    using value_type = DynamicBitset::value_type;
+
+    template<typename T, mask_type MASK>
+    size_type operator()(const Graph<T, MASK>& graph, std::vector<vertex_id_type>* clique = nullptr)
+    // returns the size of a maximum clique
+    {
+        vertices_count_ = graph.vertices_count();
+        words_count_ = DynamicBitset::words_count(vertices_count_);
+        build_adjacency(graph);
+        best_.clear();
+        current_.clear();
+        if (vertices_count_ > 0) {
+            // a clique never has more than V vertices, so buffers of all depths are allocated once
+            candidates_.assign(vertices_count_ + 1, DynamicBitset(vertices_count_));
+            colored_.resize(vertices_count_ + 1);
+            uncolored_.init(vertices_count_);
+            color_class_.init(vertices_count_);
+            candidates_[0].set();
+            expand(0);
+        }
+        if (clique != nullptr) {
+            clique->resize(best_.size());
+            for (size_type i = 0; i < best_.size(); ++i) {
+                (*clique)[i] = order_[best_[i]];
+            }
+            std::sort(clique->begin(), clique->end());
+        }
+        return best_.size();
+    }
+
+private:
+    size_type vertices_count_ = 0;
+    size_type words_count_ = 0;
+    // order_[i] is the original id of the vertex with index i, rows use the new indices
+    std::vector<vertex_id_type> order_;
+    std::vector<DynamicBitset> adjacency_;
+
+    std::vector<vertex_id_type> current_;
+    std::vector<vertex_id_type> best_;
+    // per recursion depth: candidate set and candidates with their colours in colouring order
+    std::vector<DynamicBitset> candidates_;
+    std::vector<std::vector<std::pair<vertex_id_type, size_type>>> colored_;
+    DynamicBitset uncolored_;
+    DynamicBitset color_class_;
+
+    template<typename T, mask_type MASK>
+    void build_adjacency(const Graph<T, MASK>& graph) {
+        std::vector<DynamicBitset> rows(vertices_count_, DynamicBitset(vertices_count_));
+        for (const vertex_id_type v : graph.vertices()) {
+            for (const edge_id_type id : graph.edges_list(v)) {
+                const vertex_id_type to = graph.to(id);
+                if (to != v) {
+                    rows[v].set(to);
+                    rows[to].set(v);
+                }
+            }
+        }
+        degeneracy_order(rows);
+        std::vector<vertex_id_type> index(vertices_count_);
+        for (size_type i = 0; i < vertices_count_; ++i) {
+            index[order_[i]] = i;
+        }
+        adjacency_.assign(vertices_count_, DynamicBitset(vertices_count_));
+        for (size_type i = 0; i < vertices_count_; ++i) {
+            const DynamicBitset& row = rows[order_[i]];
+            for (size_type to = row.least_significant_bit(); to < vertices_count_; to = row.first_bit_after(to)) {
+                adjacency_[i].set(index[to]);
+            }
+        }
+    }
+
+    void degeneracy_order(const std::vector<DynamicBitset>& rows)
+    // repeatedly removes a vertex of minimal remaining degree and puts it to the back, O(V^2)
+    {
+        std::vector<size_type> degree(vertices_count_);
+        for (size_type v = 0; v < vertices_count_; ++v) {
+            degree[v] = rows[v].count();
+        }
+        DynamicBitset remaining(vertices_count_);
+        remaining.set();
+        order_.resize(vertices_count_);
+        for (size_type position = vertices_count_; position-- > 0; ) {
+            vertex_id_type chosen = remaining.least_significant_bit();
+            for (vertex_id_type v = remaining.first_bit_after(chosen); v < vertices_count_; v = remaining.first_bit_after(v)) {
+                if (degree[v] < degree[chosen]) {
+                    chosen = v;
+                }
+            }
+            remaining.clear(chosen);
+            order_[position] = chosen;
+            const value_type* row = rows[chosen].data().data();
+            const value_type* alive = remaining.data().data();
+            for (size_type word = 0; word < words_count_; ++word) {
+                for (value_type bits = row[word] & alive[word]; bits != 0; bits &= bits - 1) {
+                    --degree[(word << DynamicBitset::kIndexPower) + countr_zero(bits)];
+                }
+            }
+        }
+    }
+
+    void color_sort(const size_type depth, const size_type min_color)
+    // greedy sequential colouring of the candidates, only vertices with colour >= min_color are kept
+    {
+        auto& colored = colored_[depth];
+        colored.clear();
+        uncolored_ = candidates_[depth];
+        value_type* uncolored = uncolored_.data().data();
+        value_type* color_class = color_class_.data().data();
+        size_type first_word = 0;
+        for (size_type color = 1; ; ++color) {
+            while (first_word < words_count_ && uncolored[first_word] == 0) {
+                ++first_word;
+            }
+            if (first_word == words_count_) {
+                break;
+            }
+            std::copy(uncolored + first_word, uncolored + words_count_, color_class + first_word);
+            for (size_type word = first_word; word < words_count_; ) {
+                if (color_class[word] == 0) {
+                    ++word;
+                    continue;
+                }
+                const vertex_id_type v = (word << DynamicBitset::kIndexPower) + countr_zero(color_class[word]);
+                const value_type bit = color_class[word] & (~color_class[word] + 1);
+                uncolored[word] ^= bit;
+                color_class[word] ^= bit;
+                const value_type* row = adjacency_[v].data().data();
+                for (size_type i = word; i < words_count_; ++i) {
+                    color_class[i] &= ~row[i];
+                }
+                if (color >= min_color) {
+                    colored.emplace_back(v, color);
+                }
+            }
+        }
+    }
+
+    void expand(const size_type depth) {
+        const size_type min_color = (best_.size() >= current_.size() ? best_.size() - current_.size() + 1 : 1);
+        color_sort(depth, min_color);
+
+        DynamicBitset& candidates = candidates_[depth];
+        DynamicBitset& next = candidates_[depth + 1];
+        const auto& colored = colored_[depth];
+        for (size_type i = colored.size(); i-- > 0; ) {
+            const vertex_id_type v = colored[i].first;
+            if (current_.size() + colored[i].second <= best_.size()) {
+                return;
+            }
+            current_.emplace_back(v);
+            next = candidates;
+            next &= adjacency_[v];
+            if (next.none()) {
+                if (current_.size() > best_.size()) {
+                    best_ = current_;
+                }
+            } else {
+                expand(depth + 1);
+            }
+            current_.pop_back();
+            candidates.clear(v);
+        }
+    }
+};
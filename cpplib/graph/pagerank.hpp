@@ -0,0 +1,233 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "graph.hpp"
+#include "base/parallel.hpp"
+
+class SparseMatrixVector {
+// pull-based sparse matrix-vector product over the transposed adjacency matrix:
+// y[v] = sum of x[u] * value(u -> v) over all edges u -> v.
+// Cache blocking: destinations are cut into blocks of at most kTileVertices vertices and about kBlockEdges
+// inbound edges, the unit of parallel work, so every y[v] is written by exactly one thread. Inside a destination block
+// the edges are grouped into tiles by source block of kTileVertices vertices, so a tile reads and writes only
+// kTileVertices-long slices of x and y. A tile edge is packed into 32 bits: offsets of its destination and source
+// inside their blocks. Graphs of at most kUntiledMaxVertices vertices, whose x fits into L2 anyway,
+// are multiplied straight over the inbound CSR rows of the blocks
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using packed_edge_type = uint32_t;
+
+    // slices of 2^14 doubles of x and y fit into L2 together
+    static constexpr size_type kTilePower = 14;
+    static constexpr size_type kTileVertices = static_cast<size_type>(1) << kTilePower;
+    static constexpr size_type kBlockEdges = 1 << 18;
+    static constexpr size_type kUntiledMaxVertices = 1 << 18;
+
+    static_assert(2 * kTilePower <= 32, "Both offsets of a tile edge should fit into 32 bits");
+
+    template<typename T, mask_type MASK>
+    explicit SparseMatrixVector(const Graph<T, MASK>& graph, const bool parallel = false) :
+            inbound_(graph, true),
+            out_degree_(graph.vertices_count()),
+            parallel_(parallel)
+    {
+        for (const vertex_id_type v : graph.vertices()) {
+            out_degree_[v] = graph.edges_list(v).size();
+        }
+        build_tiles();
+    }
+
+    [[nodiscard]] const CompressedGraph& inbound() const {
+        return inbound_;
+    }
+
+    [[nodiscard]] const std::vector<size_type>& out_degree() const {
+        return out_degree_;
+    }
+
+    [[nodiscard]] size_type vertices_count() const {
+        return out_degree_.size();
+    }
+
+    template<typename V>
+    void multiply(const std::vector<V>& x, std::vector<V>& y) const
+    // every edge has value 1
+    {
+        multiply_impl(x, y, [](const V& value, size_type) { return value; });
+    }
+
+    template<typename V>
+    void multiply(const std::vector<V>& x, std::vector<V>& y, const std::vector<V>& edge_values) const
+    // edge_values are aligned with inbound().targets(), use inbound().edge_ids() to fill them
+    {
+        multiply_impl(x, y, [&](const V& value, const size_type position) { return value * edge_values[position]; });
+    }
+
+private:
+    CompressedGraph inbound_;
+    std::vector<size_type> out_degree_;
+    bool parallel_;
+    bool tiled_ = false;
+
+    // destination block b is [block_start_[b], block_start_[b + 1]) and owns tiles [block_tiles_[b], block_tiles_[b + 1]);
+    // tile t reads x from tile_source_[t] and holds the edges [tile_offsets_[t], tile_offsets_[t + 1])
+    std::vector<vertex_id_type> block_start_;
+    std::vector<size_type> block_tiles_;
+    std::vector<vertex_id_type> tile_source_;
+    std::vector<size_type> tile_offsets_;
+    std::vector<packed_edge_type> edges_;
+    // position of every tile edge in inbound_
+    std::vector<size_type> inbound_positions_;
+
+    void build_tiles() {
+        const size_type vertices_count = out_degree_.size();
+        const auto& offsets = inbound_.offsets();
+        const auto& sources = inbound_.targets();
+        block_start_.assign(1, 0);
+        for (vertex_id_type v = 0; v < vertices_count; ++v) {
+            const vertex_id_type start = block_start_.back();
+            if (v + 1 == vertices_count || offsets[v + 1] - offsets[start] >= kBlockEdges || v + 1 - start >= kTileVertices) {
+                block_start_.emplace_back(v + 1);
+            }
+        }
+
+        tiled_ = (vertices_count > kUntiledMaxVertices);
+        if (!tiled_) {
+            return;
+        }
+        const size_type source_blocks_count = (vertices_count >> kTilePower) + 1;
+        std::vector<size_type> position(source_blocks_count + 1);
+        edges_.resize(inbound_.edges_count());
+        inbound_positions_.resize(inbound_.edges_count());
+        block_tiles_.assign(1, 0);
+        tile_source_.clear();
+        tile_offsets_.assign(1, 0);
+        for (size_type block = 0; block + 1 < block_start_.size(); ++block) {
+            // counting sort of the inbound edges of the block by source block
+            std::fill(position.begin(), position.end(), 0);
+            for (size_type i = offsets[block_start_[block]]; i < offsets[block_start_[block + 1]]; ++i) {
+                ++position[(sources[i] >> kTilePower) + 1];
+            }
+            position[0] = offsets[block_start_[block]];
+            for (size_type s = 0; s < source_blocks_count; ++s) {
+                if (position[s + 1] != 0) {
+                    tile_source_.emplace_back(s << kTilePower);
+                    tile_offsets_.emplace_back(position[s] + position[s + 1]);
+                }
+                position[s + 1] += position[s];
+            }
+            block_tiles_.emplace_back(tile_source_.size());
+            for (vertex_id_type v = block_start_[block]; v < block_start_[block + 1]; ++v) {
+                for (size_type i = offsets[v]; i < offsets[v + 1]; ++i) {
+                    const size_type index = position[sources[i] >> kTilePower]++;
+                    edges_[index] = static_cast<packed_edge_type>(((v - block_start_[block]) << kTilePower)
+                            | (sources[i] & (kTileVertices - 1)));
+                    inbound_positions_[index] = i;
+                }
+            }
+        }
+    }
+
+    template<typename V, typename Value>
+    void multiply_impl(const std::vector<V>& x, std::vector<V>& y, Value value) const {
+        y.resize(x.size());
+        const size_type blocks_count = block_start_.size() - 1;
+        OMP_PRAGMA(omp parallel for if(parallel_) schedule(dynamic, 1))
+        for (size_type block = 0; block < blocks_count; ++block) {
+            V* block_y = y.data() + block_start_[block];
+            if (!tiled_) {
+                const auto& offsets = inbound_.offsets();
+                const auto& sources = inbound_.targets();
+                for (vertex_id_type v = block_start_[block]; v < block_start_[block + 1]; ++v) {
+                    V sum = 0;
+                    for (size_type i = offsets[v]; i < offsets[v + 1]; ++i) {
+                        sum += value(x[sources[i]], i);
+                    }
+                    y[v] = sum;
+                }
+                continue;
+            }
+            std::fill(block_y, y.data() + block_start_[block + 1], V(0));
+            for (size_type tile = block_tiles_[block]; tile < block_tiles_[block + 1]; ++tile) {
+                const V* tile_x = x.data() + tile_source_[tile];
+                for (size_type i = tile_offsets_[tile]; i < tile_offsets_[tile + 1]; ++i) {
+                    const packed_edge_type edge = edges_[i];
+                    block_y[edge >> kTilePower] += value(tile_x[edge & (kTileVertices - 1)], inbound_positions_[i]);
+                }
+            }
+        }
+    }
+};
+
+class PageRank {
+// power iteration with double-buffered rank vectors; mass of dangling vertices is spread uniformly
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+
+    template<typename T, mask_type MASK>
+    explicit PageRank(const Graph<T, MASK>& graph, const bool parallel = false) :
+            spmv_(graph, parallel),
+            parallel_(parallel)
+    {}
+
+    size_type run(const double damping = 0.85, const double tolerance = 1e-9, const size_type max_iterations = 100)
+    // stops when the L1 distance between two consecutive rank vectors drops below tolerance,
+    // returns the number of performed iterations
+    {
+        const size_type vertices_count = spmv_.vertices_count();
+        if (vertices_count == 0) {
+            rank_.clear();
+            return 0;
+        }
+        const std::vector<size_type>& out_degree = spmv_.out_degree();
+        rank_.assign(vertices_count, 1.0 / vertices_count);
+        contribution_.resize(vertices_count);
+        size_type iteration = 0;
+        while (iteration < max_iterations) {
+            ++iteration;
+            double dangling = 0;
+            OMP_PRAGMA(omp parallel for if(parallel_) schedule(static) reduction(+ : dangling))
+            for (vertex_id_type v = 0; v < vertices_count; ++v) {
+                if (out_degree[v] == 0) {
+                    dangling += rank_[v];
+                    contribution_[v] = 0;
+                } else {
+                    contribution_[v] = rank_[v] / out_degree[v];
+                }
+            }
+            spmv_.multiply(contribution_, next_rank_);
+
+            const double base = (1 - damping + damping * dangling) / vertices_count;
+            double error = 0;
+            OMP_PRAGMA(omp parallel for if(parallel_) schedule(static) reduction(+ : error))
+            for (vertex_id_type v = 0; v < vertices_count; ++v) {
+                next_rank_[v] = base + damping * next_rank_[v];
+                error += std::fabs(next_rank_[v] - rank_[v]);
+            }
+            rank_.swap(next_rank_);
+            if (error < tolerance) {
+                break;
+            }
+        }
+        return iteration;
+    }
+
+    [[nodiscard]] const std::vector<double>& rank() const {
+        return rank_;
+    }
+
+private:
+    SparseMatrixVector spmv_;
+    bool parallel_;
+    std::vector<double> rank_;
+    std::vector<double> next_rank_;
+    std::vector<double> contribution_;
+};
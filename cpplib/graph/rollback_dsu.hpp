@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+class RollbackDSU {
+// union by size without path compression, so find_set is O(log V) and every unite can be undone
+public:
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using container_type = std::vector<vertex_id_type>;
+
+    RollbackDSU() : RollbackDSU(0) {}
+
+    explicit RollbackDSU(const size_type vertices_count) {
+        init(vertices_count);
+    }
+
+    void init(const size_type vertices_count) {
+        parent_.resize(vertices_count);
+        std::iota(parent_.begin(), parent_.end(), 0);
+        size_.assign(vertices_count, 1);
+        history_.clear();
+        sets_count_ = vertices_count;
+    }
+
+    [[nodiscard]] vertex_id_type find_set(vertex_id_type vertex) const {
+        while (vertex != parent_[vertex]) {
+            vertex = parent_[vertex];
+        }
+        return vertex;
+    }
+
+    bool unite(const vertex_id_type a, const vertex_id_type b) {
+        vertex_id_type x = find_set(a);
+        vertex_id_type y = find_set(b);
+        if (x == y) {
+            return false;
+        }
+        if (size_[x] > size_[y]) {
+            std::swap(x, y);
+        }
+        parent_[x] = y;
+        size_[y] += size_[x];
+        history_.emplace_back(x);
+        --sets_count_;
+        return true;
+    }
+
+    [[nodiscard]] size_type snapshot() const
+    // the state to return to with rollback()
+    {
+        return history_.size();
+    }
+
+    void rollback(const size_type snapshot)
+    // undoes all successful unites made after the snapshot, in reversed order
+    {
+        while (history_.size() > snapshot) {
+            const vertex_id_type x = history_.back();
+            history_.pop_back();
+            size_[parent_[x]] -= size_[x];
+            parent_[x] = x;
+            ++sets_count_;
+        }
+    }
+
+    [[nodiscard]] size_type size() const {
+        return parent_.size();
+    }
+
+    [[nodiscard]] size_type set_size(const vertex_id_type vertex) const {
+        return size_[find_set(vertex)];
+    }
+
+    [[nodiscard]] size_type sets_count() const {
+        return sets_count_;
+    }
+
+private:
+    container_type parent_;
+    std::vector<size_type> size_;
+    // roots that were attached to another root, one per successful unite
+    std::vector<vertex_id_type> history_;
+    size_type sets_count_;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "directed_graph.hpp"
+#include "collections/bitset.hpp"
+#include "maths/bits.hpp"
+
+class TransitiveClosure {
+// reflexive transitive closure of a DAG: rows are word-packed bitsets in the Bitset<N> layout,
+// both rows and columns are indexed by topological position, so row of u only has bits at positions >= position(u)
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+    using value_type = Bitset<1>::value_type;
+
+    static constexpr size_type kValueBitWidth = Bitset<1>::kValueBitWidth;
+    static constexpr size_type kIndexMask = Bitset<1>::kIndexMask;
+    static constexpr size_type kIndexPower = Bitset<1>::kIndexPower;
+
+    template<typename T, mask_type MASK>
+    bool build(const DirectedGraph<T, MASK>& graph)
+    // returns false if the graph has a cycle
+    {
+        if (!init_order(graph, order_, position_)) {
+            return false;
+        }
+        const size_type vertices_count = graph.vertices_count();
+        words_count_ = (vertices_count + kIndexMask) >> kIndexPower;
+        rows_.assign(vertices_count * words_count_, 0);
+        for (size_type i = vertices_count; i-- > 0; ) {
+            value_type* row = rows_.data() + i * words_count_;
+            row[i >> kIndexPower] |= static_cast<value_type>(1) << (i & kIndexMask);
+            for (const auto id : graph.edges_list(order_[i])) {
+                const size_type j = position_[graph.to(id)];
+                const value_type* successor_row = rows_.data() + j * words_count_;
+                for (size_type word = (j >> kIndexPower); word < words_count_; ++word) {
+                    row[word] |= successor_row[word];
+                }
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool reachable(const vertex_id_type from, const vertex_id_type to) const {
+        const size_type i = position_[from];
+        const size_type j = position_[to];
+        return j >= i && test_bit(rows_[i * words_count_ + (j >> kIndexPower)], j & kIndexMask);
+    }
+
+    [[nodiscard]] size_type reachable_count(const vertex_id_type from) const
+    // number of vertices reachable from the given one, including itself
+    {
+        const size_type i = position_[from];
+        const value_type* row = rows_.data() + i * words_count_;
+        size_type count = 0;
+        for (size_type word = (i >> kIndexPower); word < words_count_; ++word) {
+            count += popcount(row[word]);
+        }
+        return count;
+    }
+
+    [[nodiscard]] std::vector<vertex_id_type> reachable_vertices(const vertex_id_type from) const {
+        const size_type i = position_[from];
+        const value_type* row = rows_.data() + i * words_count_;
+        std::vector<vertex_id_type> result;
+        for (size_type word = (i >> kIndexPower); word < words_count_; ++word) {
+            for (value_type value = row[word]; value != 0; value &= value - 1) {
+                result.emplace_back(order_[(word << kIndexPower) + countr_zero(value)]);
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] const std::vector<vertex_id_type>& order() const {
+        return order_;
+    }
+
+    template<typename T, mask_type MASK>
+    static bool reachable_offline(
+            const DirectedGraph<T, MASK>& graph,
+            const std::vector<std::pair<vertex_id_type, vertex_id_type>>& queries,
+            std::vector<bool>* answers,
+            size_type chunk_words = 16)
+    // answers (from, to) queries with O(V * chunk_words) memory: every pass builds the closure restricted
+    // to 64 * chunk_words target columns, only rows of vertices before the chunk end (in topological order) are touched
+    // returns false if the graph has a cycle; chunk_words = 0 is treated as 1
+    {
+        chunk_words = std::max<size_type>(chunk_words, 1);
+        std::vector<vertex_id_type> order;
+        std::vector<size_type> position;
+        if (!init_order(graph, order, position)) {
+            return false;
+        }
+        const size_type vertices_count = graph.vertices_count();
+        const size_type chunk_bits = chunk_words << kIndexPower;
+        const size_type chunks_count = (vertices_count + chunk_bits - 1) / chunk_bits;
+
+        std::vector<size_type> chunk_start(chunks_count + 1, 0);
+        for (const auto& query : queries) {
+            ++chunk_start[position[query.second] / chunk_bits + 1];
+        }
+        for (size_type chunk = 0; chunk < chunks_count; ++chunk) {
+            chunk_start[chunk + 1] += chunk_start[chunk];
+        }
+        std::vector<size_type> sorted_queries(queries.size());
+        std::vector<size_type> chunk_position(chunk_start.begin(), chunk_start.end() - 1);
+        for (size_type q = 0; q < queries.size(); ++q) {
+            sorted_queries[chunk_position[position[queries[q].second] / chunk_bits]++] = q;
+        }
+
+        answers->assign(queries.size(), false);
+        std::vector<value_type> rows;
+        for (size_type chunk = 0; chunk < chunks_count; ++chunk) {
+            if (chunk_start[chunk] == chunk_start[chunk + 1]) {
+                continue;
+            }
+            const size_type first_column = chunk * chunk_bits;
+            const size_type last_column = std::min(vertices_count, first_column + chunk_bits);
+            rows.assign(last_column * chunk_words, 0);
+            for (size_type i = last_column; i-- > 0; ) {
+                value_type* row = rows.data() + i * chunk_words;
+                if (i >= first_column) {
+                    const size_type column = i - first_column;
+                    row[column >> kIndexPower] |= static_cast<value_type>(1) << (column & kIndexMask);
+                }
+                for (const auto id : graph.edges_list(order[i])) {
+                    const size_type j = position[graph.to(id)];
+                    if (j >= last_column) {
+                        continue;
+                    }
+                    const value_type* successor_row = rows.data() + j * chunk_words;
+                    for (size_type word = 0; word < chunk_words; ++word) {
+                        row[word] |= successor_row[word];
+                    }
+                }
+            }
+            for (size_type k = chunk_start[chunk]; k < chunk_start[chunk + 1]; ++k) {
+                const size_type q = sorted_queries[k];
+                const size_type i = position[queries[q].first];
+                const size_type column = position[queries[q].second] - first_column;
+                (*answers)[q] = (i < last_column && test_bit(rows[i * chunk_words + (column >> kIndexPower)], column & kIndexMask));
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<vertex_id_type> order_;
+    std::vector<size_type> position_;
+    std::vector<value_type> rows_;
+    size_type words_count_ = 0;
+
+    template<typename T, mask_type MASK>
+    static bool init_order(const DirectedGraph<T, MASK>& graph, std::vector<vertex_id_type>& order, std::vector<size_type>& position) {
+        if (!graph.top_sort_acyclic(&order)) {
+            return false;
+        }
+        position.resize(graph.vertices_count());
+        for (size_type i = 0; i < order.size(); ++i) {
+            position[order[i]] = i;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "compressed_graph.hpp"
+#include "undirected_graph.hpp"
+#include "base/parallel.hpp"
+#include "collections/dynamic_bitset.hpp"
+
+class TriangleCounting {
+// counts triangles of the simple graph underlying UndirectedGraph (self-loops and parallel edges are ignored);
+// every edge is oriented from the lower to the higher (degree, id) rank, so each triangle is found exactly once
+public:
+    using mask_type = uint32_t;
+    using size_type = std::size_t;
+    using vertex_id_type = std::size_t;
+
+    // adjacency lists up to this size are intersected by merging, longer ones through a bitset
+    static constexpr size_type kMergeIntersectionMaxDegree = 32;
+
+    template<typename T, mask_type MASK>
+    explicit TriangleCounting(const UndirectedGraph<T, MASK>& graph, const bool parallel = false) :
+            parallel_(parallel)
+    {
+        CompressedGraph adjacency(graph);
+        adjacency.simplify();
+        orient(adjacency);
+        count_triangles();
+    }
+
+    [[nodiscard]] const std::vector<size_type>& triangles() const
+    // number of triangles every vertex belongs to
+    {
+        return triangles_;
+    }
+
+    [[nodiscard]] size_type total_triangles() const {
+        return total_;
+    }
+
+    [[nodiscard]] const std::vector<size_type>& degree() const
+    // degree in the simple graph
+    {
+        return degree_;
+    }
+
+    [[nodiscard]] std::vector<double> clustering_coefficients() const
+    // local clustering coefficient: triangles(v) / (degree(v) choose 2), 0 for vertices with degree < 2
+    {
+        std::vector<double> result(triangles_.size(), 0);
+        for (size_type v = 0; v < triangles_.size(); ++v) {
+            if (degree_[v] >= 2) {
+                result[v] = 2.0 * triangles_[v] / (static_cast<double>(degree_[v]) * (degree_[v] - 1));
+            }
+        }
+        return result;
+    }
+
+    [[nodiscard]] double average_clustering() const {
+        if (triangles_.empty()) {
+            return 0;
+        }
+        const std::vector<double> coefficients = clustering_coefficients();
+        double sum = 0;
+        for (const double it : coefficients) {
+            sum += it;
+        }
+        return sum / coefficients.size();
+    }
+
+private:
+    bool parallel_;
+    std::vector<size_type> degree_;
+    std::vector<size_type> triangles_;
+    size_type total_ = 0;
+
+    // oriented adjacency over ranks: rank_vertex_[r] is the vertex with rank r
+    std::vector<vertex_id_type> rank_vertex_;
+    std::vector<size_type> offsets_;
+    std::vector<vertex_id_type> targets_;
+
+    void orient(const CompressedGraph& adjacency);
+    void count_triangles();
+
+    void add_triangle(std::vector<size_type>& count, const vertex_id_type a, const vertex_id_type b, const vertex_id_type c) const {
+        if (parallel_) {
+            OMP_PRAGMA(omp atomic)
+            ++count[a];
+            OMP_PRAGMA(omp atomic)
+            ++count[b];
+            OMP_PRAGMA(omp atomic)
+            ++count[c];
+        } else {
+            ++count[a];
+            ++count[b];
+            ++count[c];
+        }
+    }
+};
+
+inline void TriangleCounting::orient(const CompressedGraph& adjacency) {
+    const size_type vertices_count = adjacency.vertices_count();
+    degree_.resize(vertices_count);
+    size_type max_degree = 0;
+    for (vertex_id_type v = 0; v < vertices_count; ++v) {
+        degree_[v] = adjacency.degree(v);
+        max_degree = std::max(max_degree, degree_[v]);
+    }
+
+    // counting sort by degree keeps vertex ids ascending inside equal degrees
+    std::vector<size_type> bucket(max_degree + 2, 0);
+    for (const size_type d : degree_) {
+        ++bucket[d + 1];
+    }
+    for (size_type d = 0; d <= max_degree; ++d) {
+        bucket[d + 1] += bucket[d];
+    }
+    std::vector<size_type> rank(vertices_count);
+    rank_vertex_.resize(vertices_count);
+    for (vertex_id_type v = 0; v < vertices_count; ++v) {
+        rank[v] = bucket[degree_[v]]++;
+        rank_vertex_[rank[v]] = v;
+    }
+
+    offsets_.assign(vertices_count + 1, 0);
+    for (vertex_id_type v = 0; v < vertices_count; ++v) {
+        for (const vertex_id_type* it = adjacency.begin(v); it != adjacency.end(v); ++it) {
+            if (rank[v] < rank[*it]) {
+                ++offsets_[rank[v] + 1];
+            }
+        }
+    }
+    for (size_type r = 0; r < vertices_count; ++r) {
+        offsets_[r + 1] += offsets_[r];
+    }
+    targets_.resize(offsets_.back());
+    for (size_type r = 0; r < vertices_count; ++r) {
+        const vertex_id_type v = rank_vertex_[r];
+        size_type position = offsets_[r];
+        for (const vertex_id_type* it = adjacency.begin(v); it != adjacency.end(v); ++it) {
+            if (r < rank[*it]) {
+                targets_[position++] = rank[*it];
+            }
+        }
+        std::sort(targets_.begin() + offsets_[r], targets_.begin() + position);
+    }
+}
+
+inline void TriangleCounting::count_triangles() {
+    const size_type vertices_count = rank_vertex_.size();
+    std::vector<size_type> count(vertices_count, 0);
+    std::vector<DynamicBitset> marked(parallel_ ? parallel_threads_count() : 1);
+    size_type total = 0;
+
+    OMP_PRAGMA(omp parallel for if(parallel_) schedule(dynamic, 64) reduction(+ : total))
+    for (size_type a = 0; a < vertices_count; ++a) {
+        const vertex_id_type* a_begin = targets_.data() + offsets_[a];
+        const vertex_id_type* a_end = targets_.data() + offsets_[a + 1];
+        if (static_cast<size_type>(a_end - a_begin) <= kMergeIntersectionMaxDegree) {
+            for (const vertex_id_type* it = a_begin; it != a_end; ++it) {
+                const vertex_id_type b = *it;
+                const vertex_id_type* x = a_begin;
+                const vertex_id_type* y = targets_.data() + offsets_[b];
+                const vertex_id_type* y_end = targets_.data() + offsets_[b + 1];
+                while (x != a_end && y != y_end) {
+                    if (*x < *y) {
+                        ++x;
+                    } else if (*y < *x) {
+                        ++y;
+                    } else {
+                        add_triangle(count, a, b, *x);
+                        ++total;
+                        ++x;
+                        ++y;
+                    }
+                }
+            }
+            continue;
+        }
+        DynamicBitset& bits = marked[parallel_ ? parallel_thread_id() : 0];
+        if (bits.size() != vertices_count) {
+            bits.init(vertices_count);
+        }
+        for (const vertex_id_type* it = a_begin; it != a_end; ++it) {
+            bits.set(*it);
+        }
+        for (const vertex_id_type* it = a_begin; it != a_end; ++it) {
+            const vertex_id_type b = *it;
+            for (size_type i = offsets_[b]; i < offsets_[b + 1]; ++i) {
+                if (bits.get(targets_[i])) {
+                    add_triangle(count, a, b, targets_[i]);
+                    ++total;
+                }
+            }
+        }
+        for (const vertex_id_type* it = a_begin; it != a_end; ++it) {
+            bits.clear(*it);
+        }
+    }
+
+    triangles_.resize(vertices_count);
+    for (size_type r = 0; r < vertices_count; ++r) {
+        triangles_[rank_vertex_[r]] = count[r];
+    }
+    total_ = total;
+}
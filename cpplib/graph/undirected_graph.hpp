@@ -1,6 +1,8 @@
 #pragma once
 #include <type_traits>
+#include <vector>
 
+#include "connected_components.hpp"
 #include "dsu.hpp"
 #include "graph.hpp"
 
@@ -49,7 +51,11 @@ public:
     }
 
     [[nodiscard]] bool is_connected() const {
-        return dsu().sets_count() == 1;
+        return components_count() == 1;
+    }
+
+    [[nodiscard]] size_type components_count() const {
+        return ConnectedComponents()(*this);
     }
 
     [[nodiscard]] DSU dsu() const {
@@ -60,7 +66,11 @@ public:
         return dsu;
     }
 
-    [[nodiscard]] DSU::container_type labelled_components() const {
-        return dsu().finalize().data();
+    [[nodiscard]] std::vector<vertex_id_type> labelled_components(const bool parallel = false) const
+    // each vertex is labelled with the minimal vertex id of its component
+    {
+        std::vector<vertex_id_type> labels;
+        ConnectedComponents()(*this, &labels, parallel);
+        return labels;
     }
 };
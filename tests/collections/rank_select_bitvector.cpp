@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpplib/collections/dynamic_bitset.hpp"
+#include "cpplib/collections/rank_select_bitvector.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+void check_against_naive(const std::vector<bool>& bits, const RankSelectBitvector& bitvector) {
+    ASSERT_EQ(bitvector.size(), bits.size());
+    std::vector<size_t> ones;
+    std::vector<size_t> zeros;
+    for (size_t i = 0; i < bits.size(); ++i) {
+        ASSERT_EQ(bitvector.rank1(i), ones.size());
+        ASSERT_EQ(bitvector.rank0(i), zeros.size());
+        ASSERT_EQ(bitvector[i], bits[i]);
+        (bits[i] ? ones : zeros).emplace_back(i);
+    }
+    ASSERT_EQ(bitvector.rank1(bits.size()), ones.size());
+    ASSERT_EQ(bitvector.ones_count(), ones.size());
+    ASSERT_EQ(bitvector.zeros_count(), zeros.size());
+    for (size_t k = 0; k < ones.size(); ++k) {
+        ASSERT_EQ(bitvector.select1(k), ones[k]);
+    }
+    for (size_t k = 0; k < zeros.size(); ++k) {
+        ASSERT_EQ(bitvector.select0(k), zeros[k]);
+    }
+}
+
+}  // namespace
+
+TEST(RankSelectBitvector, random_densities_match_naive) {
+    for (const size_t n : {0, 1, 63, 64, 65, 511, 512, 4095, 4096, 4097, 20000, 100000}) {
+        // one in a million is sparse enough to leave whole superblocks empty
+        for (const int density : {0, 1, 500, 999999, 1000000}) {
+            std::vector<bool> bits(n);
+            RankSelectBitvector bitvector(n);
+            for (size_t i = 0; i < n; ++i) {
+                bits[i] = Random::get<int>(1, 1000000) <= density;
+                if (bits[i]) {
+                    bitvector.set(i);
+                }
+            }
+            bitvector.build();
+            check_against_naive(bits, bitvector);
+        }
+    }
+}
+
+TEST(RankSelectBitvector, from_dynamic_bitset) {
+    const size_t n = 10000;
+    std::vector<bool> bits(n);
+    DynamicBitset bitset(n);
+    for (size_t i = 0; i < n; ++i) {
+        bits[i] = Random::get<int>(0, 3) == 0;
+        if (bits[i]) {
+            bitset.set(i);
+        }
+    }
+    check_against_naive(bits, RankSelectBitvector(bitset));
+}
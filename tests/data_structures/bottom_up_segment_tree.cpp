@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/bottom_up_segment_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+struct Sum {
+    int64_t operator()(const int64_t a, const int64_t b) const {
+        return a + b;
+    }
+};
+
+}  // namespace
+
+TEST(BottomUpSegmentTree, non_commutative_merge_keeps_order) {
+    for (const size_t n : {1, 2, 5, 16, 33}) {
+        std::vector<std::string> a(n);
+        for (auto& it : a) {
+            it = std::string(1, static_cast<char>('a' + Random::get<int>(0, 25)));
+        }
+        BottomUpSegmentTree<std::string> tree(a.begin(), a.end(), [](const std::string& x, const std::string& y) {
+            return x + y;
+        }, "");
+        for (size_t it = 0; it < 200; ++it) {
+            const size_t position = Random::get<size_t>(0, n - 1);
+            a[position] = std::string(1, static_cast<char>('a' + Random::get<int>(0, 25)));
+            tree.update(position, a[position]);
+            size_t left = Random::get<size_t>(0, n - 1);
+            size_t right = Random::get<size_t>(0, n - 1);
+            if (left > right) {
+                std::swap(left, right);
+            }
+            std::string expected;
+            for (size_t i = left; i <= right; ++i) {
+                expected += a[i];
+            }
+            ASSERT_EQ(tree.query(left, right), expected);
+            ASSERT_EQ(tree.get(position), a[position]);
+        }
+    }
+}
+
+TEST(BottomUpSegmentTree, max_right_and_min_left_match_naive) {
+    for (const size_t n : {1, 3, 8, 13, 64, 100}) {
+        std::vector<int64_t> a(n);
+        for (auto& it : a) {
+            it = Random::get<int64_t>(0, 10);
+        }
+        BottomUpSegmentTree<int64_t, Sum> tree(a.begin(), a.end(), Sum());
+        for (size_t it = 0; it < 300; ++it) {
+            const int64_t limit = Random::get<int64_t>(0, 60);
+            const auto pred = [limit](const int64_t sum) {
+                return sum <= limit;
+            };
+            const size_t border = Random::get<size_t>(0, n);
+
+            size_t expected_right = border;
+            for (int64_t sum = 0; expected_right < n && sum + a[expected_right] <= limit; ++expected_right) {
+                sum += a[expected_right];
+            }
+            ASSERT_EQ(tree.max_right(border, pred), expected_right);
+
+            size_t expected_left = border;
+            for (int64_t sum = 0; expected_left > 0 && sum + a[expected_left - 1] <= limit; --expected_left) {
+                sum += a[expected_left - 1];
+            }
+            ASSERT_EQ(tree.min_left(border, pred), expected_left);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/disjoint_sparse_table.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+struct Concatenate {
+    std::string operator()(const std::string& a, const std::string& b) const {
+        return a + b;
+    }
+};
+
+// 2x2 matrices modulo a prime: associative, not commutative and not idempotent
+using Matrix = std::array<uint64_t, 4>;
+
+struct Multiply {
+    static constexpr uint64_t kMod = 1000000007;
+
+    Matrix operator()(const Matrix& a, const Matrix& b) const {
+        return {(a[0] * b[0] + a[1] * b[2]) % kMod, (a[0] * b[1] + a[1] * b[3]) % kMod,
+                (a[2] * b[0] + a[3] * b[2]) % kMod, (a[2] * b[1] + a[3] * b[3]) % kMod};
+    }
+};
+
+}  // namespace
+
+TEST(DisjointSparseTable, concatenation_of_all_ranges) {
+    for (const size_t n : {1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 40}) {
+        std::vector<std::string> a(n);
+        for (auto& it : a) {
+            it = std::string(1, static_cast<char>('a' + Random::get<int>(0, 25)));
+        }
+        const DisjointSparseTable<std::string, Concatenate> table(a);
+        ASSERT_EQ(table.size(), n);
+        for (size_t left = 0; left < n; ++left) {
+            std::string expected;
+            for (size_t right = left + 1; right <= n; ++right) {
+                expected += a[right - 1];
+                ASSERT_EQ(table.query(left, right), expected);
+            }
+        }
+    }
+}
+
+TEST(DisjointSparseTable, matrix_products_match_naive) {
+    const size_t n = 1000;
+    std::vector<Matrix> a(n);
+    for (auto& it : a) {
+        for (auto& cell : it) {
+            cell = Random::get<uint64_t>(0, Multiply::kMod - 1);
+        }
+    }
+    const DisjointSparseTable<Matrix, Multiply> table(a.begin(), a.end());
+    for (size_t it = 0; it < 2000; ++it) {
+        size_t left = Random::get<size_t>(0, n - 1);
+        size_t right = Random::get<size_t>(0, n - 1);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        Matrix expected = a[left];
+        for (size_t i = left + 1; i <= right; ++i) {
+            expected = Multiply()(expected, a[i]);
+        }
+        ASSERT_EQ(table.query(left, right + 1), expected);
+    }
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/dynamic_segment_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+// sums are taken modulo 2^64, so segments of length up to 2^63 do not overflow
+struct Sum {
+    uint64_t operator()(const uint64_t a, const uint64_t b) const {
+        return a + b;
+    }
+};
+
+struct ApplyAdd {
+    uint64_t operator()(const uint64_t value, const uint64_t update, const uint64_t left, const uint64_t right) const {
+        return value + update * (right - left + 1);
+    }
+};
+
+using Tree = DynamicSegmentTree<uint64_t, Sum, uint64_t, ApplyAdd, Sum>;
+
+class NaiveArray {
+// piecewise constant array over [0, limit): every key starts a segment which lasts till the next key
+public:
+    explicit NaiveArray(const uint64_t limit) {
+        segments_[0] = 0;
+        segments_[limit] = 0;
+    }
+
+    void add(const uint64_t left, const uint64_t right, const uint64_t delta) {
+        split(right + 1);
+        for (auto it = split(left); it->first <= right; ++it) {
+            it->second += delta;
+        }
+    }
+
+    void assign(const uint64_t left, const uint64_t right, const uint64_t value) {
+        split(right + 1);
+        for (auto it = split(left); it->first <= right; ++it) {
+            it->second = value;
+        }
+    }
+
+    uint64_t sum(const uint64_t left, const uint64_t right) {
+        split(right + 1);
+        uint64_t result = 0;
+        for (auto it = split(left); it->first <= right; ++it) {
+            result += it->second * (std::next(it)->first - it->first);
+        }
+        return result;
+    }
+
+private:
+    std::map<uint64_t, uint64_t> segments_;
+
+    std::map<uint64_t, uint64_t>::iterator split(const uint64_t position)
+    // returns the segment starting at position, splitting the one containing it if needed
+    {
+        auto it = std::prev(segments_.upper_bound(position));
+        if (it->first != position) {
+            it = segments_.emplace(position, it->second).first;
+        }
+        return it;
+    }
+};
+
+uint64_t random_coordinate(const std::vector<uint64_t>& anchors) {
+    const uint64_t anchor = anchors[Random::get<size_t>(0, anchors.size() - 1)];
+    const uint64_t shift = Random::get<uint64_t>(0, 3);
+    return std::min(anchor + shift, Tree::kMaxCoordinatesLimit - 1);
+}
+
+}  // namespace
+
+TEST(DynamicSegmentTree, huge_coordinates_match_naive) {
+    std::vector<uint64_t> anchors{0, Tree::kMaxCoordinatesLimit - 1};
+    for (size_t i = 0; i < 20; ++i) {
+        anchors.emplace_back(Random::get<uint64_t>(0, Tree::kMaxCoordinatesLimit - 1));
+    }
+    Tree tree;
+    NaiveArray naive(Tree::kMaxCoordinatesLimit);
+    for (size_t it = 0; it < 3000; ++it) {
+        uint64_t left = random_coordinate(anchors);
+        uint64_t right = random_coordinate(anchors);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        const uint64_t value = Random::get<uint64_t>(0, 1000);
+        switch (Random::get<int>(0, 4)) {
+            case 0:
+                tree.range_update(left, right, value);
+                naive.add(left, right, value);
+                break;
+            case 1:
+                tree.set(left, value);
+                naive.assign(left, left, value);
+                break;
+            case 2:
+                tree.erase(left, right);
+                naive.assign(left, right, 0);
+                break;
+            case 3:
+                tree.compact();
+                break;
+            default:
+                tree.point_update(right, value);
+                naive.add(right, right, value);
+                break;
+        }
+        ASSERT_EQ(tree.get(left, right), naive.sum(left, right));
+        ASSERT_EQ(tree.get(right), naive.sum(right, right));
+        ASSERT_EQ(tree.get_all(), naive.sum(0, Tree::kMaxCoordinatesLimit - 1));
+    }
+}
+
+TEST(DynamicSegmentTree, small_limit_matches_array) {
+    for (const uint64_t limit : {1, 2, 5, 100}) {
+        Tree tree(limit);
+        std::vector<uint64_t> a(limit, 0);
+        for (size_t it = 0; it < 1000; ++it) {
+            uint64_t left = Random::get<uint64_t>(0, limit - 1);
+            uint64_t right = Random::get<uint64_t>(0, limit - 1);
+            if (left > right) {
+                std::swap(left, right);
+            }
+            const uint64_t value = Random::get<uint64_t>(0, 1000);
+            if (Random::get<int>(0, 1) == 0) {
+                tree.range_update(left, right, value);
+                for (uint64_t i = left; i <= right; ++i) {
+                    a[i] += value;
+                }
+            } else {
+                tree.erase(left, right);
+                std::fill(a.begin() + left, a.begin() + right + 1, 0);
+            }
+            uint64_t sum = 0;
+            for (uint64_t i = left; i <= right; ++i) {
+                sum += a[i];
+            }
+            ASSERT_EQ(tree.get(left, right), sum);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpplib/data_structures/enhanced_suffix_array.hpp"
+#include "cpplib/data_structures/fm_index.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+using Index = EnhancedSuffixArray<>::index_type;
+
+std::string random_string(const size_t n, const char max_char) {
+    std::string s(n, 'a');
+    for (auto& it : s) {
+        it = static_cast<char>(Random::get<int>('a', max_char));
+    }
+    return s;
+}
+
+Index common_prefix(const std::string& s, const Index a, const Index b) {
+    Index length = 0;
+    while (a + length < static_cast<Index>(s.length()) && b + length < static_cast<Index>(s.length())
+            && s[a + length] == s[b + length]) {
+        ++length;
+    }
+    return length;
+}
+
+void check_find(const std::string& s, const EnhancedSuffixArray<>& esa, const std::string& pattern) {
+    Index expected = 0;
+    for (size_t i = 0; i < s.length(); ++i) {
+        if (s.compare(i, pattern.length(), pattern) == 0) {
+            ++expected;
+        }
+    }
+    ASSERT_EQ(esa.count(pattern), expected) << s << " " << pattern;
+    const auto interval = esa.find(pattern);
+    ASSERT_EQ(interval.second - interval.first, expected);
+    for (Index i = interval.first; i < interval.second; ++i) {
+        ASSERT_EQ(s.compare(esa.sa()[i], pattern.length(), pattern), 0);
+    }
+}
+
+}  // namespace
+
+TEST(EnhancedSuffixArray, lcp_matches_naive) {
+    for (const char max_char : {'a', 'b', 'd'}) {
+        for (size_t it = 0; it < 100; ++it) {
+            const std::string s = random_string(Random::get<size_t>(1, 100), max_char);
+            const EnhancedSuffixArray<> esa(s);
+            const std::vector<Index>& sa = esa.sa();
+            for (size_t i = 1; i < sa.size(); ++i) {
+                ASSERT_LT(s.compare(sa[i - 1], std::string::npos, s, sa[i], std::string::npos), 0);
+                ASSERT_EQ(esa.lcp()[i], common_prefix(s, sa[i - 1], sa[i]));
+            }
+            ASSERT_EQ(esa.lcp().front(), -1);
+            ASSERT_EQ(esa.lcp().back(), -1);
+        }
+    }
+}
+
+TEST(EnhancedSuffixArray, find_matches_naive) {
+    for (const char max_char : {'a', 'b', 'c', 'z'}) {
+        for (size_t it = 0; it < 100; ++it) {
+            const std::string s = random_string(Random::get<size_t>(1, 100), max_char);
+            const EnhancedSuffixArray<> esa(s);
+            for (size_t q = 0; q < 30; ++q) {
+                const size_t from = Random::get<size_t>(0, s.length() - 1);
+                const size_t length = Random::get<size_t>(0, s.length() - from);
+                // substrings with an occasional changed last char, which may or may not occur
+                std::string pattern = s.substr(from, length);
+                if (!pattern.empty() && Random::get<int>(0, 2) == 0) {
+                    pattern.back() = static_cast<char>(Random::get<int>('a', max_char + 1));
+                }
+                check_find(s, esa, pattern);
+            }
+            check_find(s, esa, s + "a");
+        }
+    }
+}
+
+TEST(EnhancedSuffixArray, bytes_above_127) {
+    const std::string s = "\xff\x01\x80\xff\x80\x01\xff\x80";
+    const EnhancedSuffixArray<> esa(s);
+    for (const std::string& pattern : {std::string("\xff"), std::string("\xff\x80"), std::string("\x80\x01"),
+                                       std::string("\x01\xff"), std::string("\x7f")}) {
+        check_find(s, esa, pattern);
+    }
+}
+
+TEST(EnhancedSuffixArray, intervals_and_children) {
+    for (size_t it = 0; it < 100; ++it) {
+        const std::string s = random_string(Random::get<size_t>(2, 80), 'c');
+        const EnhancedSuffixArray<> esa(s);
+        const std::vector<Index>& sa = esa.sa();
+        const std::vector<Index>& lcp = esa.lcp();
+        size_t intervals = 0;
+        esa.traverse_bottom_up([&](const Index value, const EnhancedSuffixArray<>::interval_type& interval) {
+            ++intervals;
+            ASSERT_GE(interval.second - interval.first, 2);
+            ASSERT_EQ(esa.lcp_value(interval), value);
+            // all suffixes share value chars and the interval can not be extended
+            for (Index i = interval.first + 1; i < interval.second; ++i) {
+                ASSERT_GE(lcp[i], value);
+            }
+            ASSERT_LT(lcp[interval.first], value);
+            ASSERT_LT(lcp[interval.second], value);
+            Index next = interval.first;
+            esa.for_each_child(interval, [&](const EnhancedSuffixArray<>::interval_type& child) {
+                ASSERT_EQ(child.first, next);
+                ASSERT_LT(child.first, child.second);
+                if (child.second - child.first > 1) {
+                    ASSERT_GT(esa.lcp_value(child), value);
+                }
+                next = child.second;
+            });
+            ASSERT_EQ(next, interval.second);
+        });
+        ASSERT_GE(intervals, 1u);
+        ASSERT_EQ(esa.find("").first, 0);
+        ASSERT_EQ(esa.count(""), static_cast<Index>(sa.size()));
+    }
+}
+
+TEST(EnhancedSuffixArray, same_counts_as_fm_index) {
+    for (const size_t n : {0, 1, 2, 50}) {
+        const std::string s = random_string(n, 'c');
+        const EnhancedSuffixArray<> esa(s);
+        const FMIndex fm(s);
+        for (const std::string& pattern : {std::string(), std::string("a"), std::string("ab"), std::string("ca")}) {
+            ASSERT_EQ(static_cast<size_t>(esa.count(pattern)), fm.count(pattern));
+        }
+        ASSERT_EQ(fm.count(""), n);
+    }
+}
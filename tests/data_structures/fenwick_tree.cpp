@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <numeric>
+#include <utility>
+#include <vector>
+
 #include "cpplib/data_structures/fenwick_tree/fenwick_tree.hpp"
 
 TEST(FenwickTreeSum, build_from_vector) {
@@ -56,3 +60,78 @@ TEST(FenwickTreeSum, fast_range_query) {
 	check({0, 0, 0, 0, 54});
 	check({});
 }
+
+TEST(FenwickTreeSum, lower_bound) {
+	auto check = [](std::initializer_list<int>&& init_list) {
+		const std::vector<int> a(init_list);
+		const FenwickTreeSum<int> fenwick_tree(a);
+		const int total = std::accumulate(a.begin(), a.end(), 0);
+		for (int value = 0; value <= total + 1; ++value) {
+			size_t expected = 0;
+			for (int prefix = 0; expected < a.size(); ++expected) {
+				prefix += a[expected];
+				if (prefix >= value) {
+					break;
+				}
+			}
+			EXPECT_EQ(expected, fenwick_tree.lower_bound(value));
+		}
+	};
+
+	check({1, 2, 3, 7, 117, 54});
+	check({100, 2000, 30000, 9000});
+	check({1});
+	check({0});
+	check({1, 1, 1, 1});
+	check({0, 0, 0, 0, 0});
+	check({117, 0, 0, 0});
+	check({0, 0, 0, 0, 54});
+	check({0, 3, 0, 0, 2, 0, 0});
+	check({});
+}
+
+TEST(FenwickTreeSum, batch_inc) {
+	auto check = [](const size_t n, const std::vector<std::pair<size_t, int>>& updates) {
+		FenwickTreeSum<int> expected(n);
+		for (const auto& update : updates) {
+			expected.inc(update.first, update.second);
+		}
+
+		FenwickTreeSum<int> fenwick_tree(n);
+		fenwick_tree.inc(updates);
+		EXPECT_EQ(expected, fenwick_tree);
+
+		FenwickTreeSum<int> built(std::vector<int>(n, 5));
+		FenwickTreeSum<int> expected_built(std::vector<int>(n, 5));
+		built.inc(updates);
+		for (const auto& update : updates) {
+			expected_built.inc(update.first, update.second);
+		}
+		EXPECT_EQ(expected_built, built);
+	};
+
+	check(6, {{0, 1}, {1, 2}, {2, 3}, {3, 7}, {4, 117}, {5, 54}});
+	check(6, {{5, 1}, {5, -2}, {0, 3}, {2, 7}, {2, 117}, {3, 54}, {1, 1}, {4, 4}});
+	check(1000, {{17, 1}, {999, 2}});
+	check(4, {});
+	check(0, {});
+}
+
+TEST(FenwickTreeSum, batch_prefix_query) {
+	auto check = [](std::initializer_list<int>&& init_list, const std::vector<size_t>& indices) {
+		const FenwickTreeSum<int> fenwick_tree(init_list);
+		std::vector<int> results;
+		fenwick_tree.query(indices, &results);
+		ASSERT_EQ(indices.size(), results.size());
+		for (size_t i = 0; i < indices.size(); ++i) {
+			EXPECT_EQ(fenwick_tree.query(indices[i]), results[i]);
+		}
+	};
+
+	check({1, 2, 3, 7, 117, 54}, {0, 1, 2, 3, 4, 5});
+	check({1, 2, 3, 7, 117, 54}, {2, 2, 5, 5});
+	check({100, 2000, 30000, 9000}, {3});
+	check({1}, {0, 0});
+	check({0, 0, 0, 0, 54}, {1, 4});
+	check({117, 0, 0, 0}, {});
+}
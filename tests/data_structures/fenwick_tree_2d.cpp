@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "cpplib/data_structures/fenwick_tree/fenwick_tree_2d.hpp"
+#include "cpplib/data_structures/fenwick_tree/fenwick_tree_2d_compressed.hpp"
 #include "base/helpers.hpp"
 #include "range/ranges.hpp"
 #include "maths/random.hpp"
@@ -42,3 +43,138 @@ TEST(FenwickTreeSum2D, check_range_query) {
         }
     }
 }
+
+TEST(FenwickTreeSum2DFlat, check_range_query) {
+    const int kMaxn = 30;
+    const int kMaxm = 45;
+    const int kMaxValue = 10;
+
+    FenwickTreeSum2D<int> tree(kMaxn, kMaxm);
+    FenwickTreeSum2DFlat<int> flat_tree(kMaxn, kMaxm);
+    for (int i : range(kMaxn)) {
+        for (int j : range(kMaxm)) {
+            const int value = Random::get(1, kMaxValue);
+            tree.inc(i, j, value);
+            flat_tree.inc(i, j, value);
+        }
+    }
+
+    for (int x1 : range(kMaxn)) {
+        for (int y1 : range(kMaxm)) {
+            for (int x2 : range(x1, kMaxn)) {
+                for (int y2 : range(y1, kMaxm)) {
+                    EXPECT_EQ(tree.query(x1, y1, x2, y2), flat_tree.query(x1, y1, x2, y2));
+                }
+            }
+        }
+    }
+}
+
+TEST(CompressedFenwickTreeSum2D, check_range_query) {
+    const int kPoints = 200;
+    const int kQueries = 5000;
+    const int64_t kMaxCoordinate = 1000000000000LL;
+    const int kMaxValue = 10;
+
+    std::vector<std::pair<int64_t, int64_t>> points;
+    CompressedFenwickTreeSum2D<int64_t> tree;
+    for (int i : range(kPoints)) {
+        // a few repeated x and y to get several points per row and column
+        const int64_t x = (i % 3 == 0 && i > 0 ? points[i - 1].first : Random::get(-kMaxCoordinate, kMaxCoordinate));
+        const int64_t y = (i % 5 == 0 && i > 0 ? points[i - 1].second : Random::get(-kMaxCoordinate, kMaxCoordinate));
+        points.emplace_back(x, y);
+        tree.add_point(x, y);
+    }
+    tree.build();
+
+    std::vector<int64_t> values(kPoints, 0);
+    for (int i : range(kPoints)) {
+        const int64_t value = Random::get(1, kMaxValue);
+        values[i] += value;
+        EXPECT_TRUE(tree.inc(points[i].first, points[i].second, value));
+    }
+    EXPECT_FALSE(tree.inc(kMaxCoordinate + 1, points[0].second, 1));
+    EXPECT_FALSE(tree.inc(points[0].first, kMaxCoordinate + 1, 1));
+
+    for (int i : range(kQueries)) {
+        const auto& a = points[Random::get(0, kPoints - 1)];
+        const auto& b = points[Random::get(0, kPoints - 1)];
+        int64_t x1 = std::min(a.first, b.first);
+        int64_t x2 = std::max(a.first, b.first);
+        int64_t y1 = std::min(a.second, b.second);
+        int64_t y2 = std::max(a.second, b.second);
+        if (i % 2 == 1) {
+            x1 += Random::get(-1, 1);
+            y2 += Random::get(-1, 1);
+        }
+        int64_t expected = 0;
+        for (int j : range(kPoints)) {
+            if (x1 <= points[j].first && points[j].first <= x2 && y1 <= points[j].second && points[j].second <= y2) {
+                expected += values[j];
+            }
+        }
+        EXPECT_EQ(expected, tree.query(x1, y1, x2, y2));
+    }
+}
+
+TEST(CompressedFenwickTreeSum2D, inc_accepts_exactly_stored_updates) {
+    CompressedFenwickTreeSum2D<int64_t> tree;
+    tree.add_point(0, 5);
+    tree.add_point(1, 7);
+    tree.build();
+    // the outer node of x = 1 covers x = 0 as well, so {1, 5} is stored exactly
+    EXPECT_TRUE(tree.inc(1, 5, 3));
+    EXPECT_EQ(tree.query(1, 5, 1, 5), 3);
+    EXPECT_EQ(tree.query(0, 5, 0, 5), 0);
+    // the outer node of x = 0 holds only y = 5
+    EXPECT_FALSE(tree.inc(0, 7, 1));
+    EXPECT_EQ(tree.query(0, 0, 1, 10), 3);
+}
+
+TEST(FenwickTreeSumRangeUpdates2D, check_range_update_range_query) {
+    const int kMaxn = 12;
+    const int kMaxm = 17;
+    const int kUpdates = 300;
+    const int kMaxValue = 10;
+
+    auto a = make_vector<int64_t>(kMaxn, kMaxm, 0);
+    FenwickTreeSumRangeUpdates2D<int64_t> tree(kMaxn, kMaxm);
+    for (int i : range(kUpdates)) {
+        int x1 = Random::get(0, kMaxn - 1);
+        int x2 = Random::get(0, kMaxn - 1);
+        int y1 = Random::get(0, kMaxm - 1);
+        int y2 = Random::get(0, kMaxm - 1);
+        if (x1 > x2) {
+            std::swap(x1, x2);
+        }
+        if (y1 > y2) {
+            std::swap(y1, y2);
+        }
+        const int64_t delta = Random::get(-kMaxValue, kMaxValue);
+        tree.update(x1, y1, x2, y2, delta);
+        for (int x : range(x1, x2 + 1)) {
+            for (int y : range(y1, y2 + 1)) {
+                a[x][y] += delta;
+            }
+        }
+
+        if (i % 50 != 0) {
+            continue;
+        }
+        for (int qx1 : range(kMaxn)) {
+            for (int qy1 : range(kMaxm)) {
+                for (int qx2 : range(qx1, kMaxn)) {
+                    for (int qy2 : range(qy1, kMaxm)) {
+                        int64_t expected = 0;
+                        for (int x : range(qx1, qx2 + 1)) {
+                            for (int y : range(qy1, qy2 + 1)) {
+                                expected += a[x][y];
+                            }
+                        }
+                        EXPECT_EQ(expected, tree.query(qx1, qy1, qx2, qy2));
+                    }
+                }
+            }
+        }
+    }
+}
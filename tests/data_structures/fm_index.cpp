@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "cpplib/data_structures/fm_index.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+std::string random_string(const size_t n, const char max_char) {
+    std::string s(n, 'a');
+    for (auto& it : s) {
+        it = static_cast<char>(Random::get<int>('a', max_char));
+    }
+    return s;
+}
+
+std::vector<size_t> naive_locate(const std::string& s, const std::string& pattern) {
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < s.length(); ++i) {
+        if (s.compare(i, pattern.length(), pattern) == 0) {
+            positions.emplace_back(i);
+        }
+    }
+    return positions;
+}
+
+void check_against_naive(const std::string& s, const FMIndex& fm, const std::string& pattern) {
+    const std::vector<size_t> expected = naive_locate(s, pattern);
+    ASSERT_EQ(fm.count(pattern), expected.size());
+    std::vector<size_t> positions = fm.locate(pattern);
+    std::sort(positions.begin(), positions.end());
+    ASSERT_EQ(positions, expected);
+}
+
+}  // namespace
+
+TEST(FMIndex, count_and_locate_match_naive) {
+    for (const size_t sample_rate : {1, 2, 7, 32}) {
+        for (const char max_char : {'a', 'b', 'd', 'z'}) {
+            for (size_t it = 0; it < 30; ++it) {
+                const std::string s = random_string(Random::get<size_t>(1, 300), max_char);
+                const FMIndex fm(s, sample_rate);
+                ASSERT_EQ(fm.size(), s.length());
+                for (size_t q = 0; q < 20; ++q) {
+                    const size_t from = Random::get<size_t>(0, s.length() - 1);
+                    std::string pattern = s.substr(from, Random::get<size_t>(0, 6));
+                    if (!pattern.empty() && Random::get<int>(0, 2) == 0) {
+                        pattern.back() = static_cast<char>(Random::get<int>('a', max_char + 1));
+                    }
+                    check_against_naive(s, fm, pattern);
+                }
+            }
+        }
+    }
+}
+
+TEST(FMIndex, all_byte_values) {
+    std::string s(2000, '\0');
+    for (auto& it : s) {
+        it = static_cast<char>(Random::get<int>(0, 255));
+    }
+    const FMIndex fm(s, 5);
+    for (size_t q = 0; q < 200; ++q) {
+        check_against_naive(s, fm, s.substr(Random::get<size_t>(0, s.length() - 1), Random::get<size_t>(1, 3)));
+    }
+    check_against_naive(s, fm, std::string(1, '\0'));
+}
+
+TEST(FMIndex, empty_text_and_invalid_sample_rate) {
+    const FMIndex fm(std::string(), 4);
+    ASSERT_EQ(fm.size(), 0u);
+    ASSERT_EQ(fm.count(""), 0u);
+    ASSERT_EQ(fm.count("a"), 0u);
+
+    FMIndex index;
+    ASSERT_FALSE(index.build("abc", 3, 0));
+    ASSERT_EQ(index.words_count(), 0u);
+    ASSERT_EQ(index.count("a"), 0u);
+}
+
+TEST(FMIndex, save_load_and_attach) {
+    const std::string s = random_string(5000, 'e');
+    const FMIndex fm(s, 16);
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_TRUE(fm.save(file));
+    std::rewind(file);
+    FMIndex loaded;
+    ASSERT_TRUE(loaded.load(file));
+    std::fclose(file);
+
+    const std::vector<FMIndex::word_type> words(fm.data(), fm.data() + fm.words_count());
+    FMIndex attached;
+    ASSERT_TRUE(attached.attach(words.data(), words.size()));
+    ASSERT_EQ(attached.data(), words.data());
+    for (size_t q = 0; q < 50; ++q) {
+        const std::string pattern = s.substr(Random::get<size_t>(0, s.length() - 1), Random::get<size_t>(1, 5));
+        check_against_naive(s, loaded, pattern);
+        check_against_naive(s, attached, pattern);
+    }
+}
+
+TEST(FMIndex, corrupted_data_is_rejected) {
+    const FMIndex fm(std::string("abracadabra"), 3);
+    const std::vector<FMIndex::word_type> words(fm.data(), fm.data() + fm.words_count());
+    FMIndex index;
+    ASSERT_TRUE(index.attach(words.data(), words.size()));
+
+    ASSERT_FALSE(index.attach(words.data(), words.size() - 1));
+    ASSERT_EQ(index.words_count(), 0u);
+    ASSERT_EQ(index.count("a"), 0u);
+
+    std::vector<FMIndex::word_type> bad_magic = words;
+    ++bad_magic[0];
+    ASSERT_FALSE(index.attach(bad_magic.data(), bad_magic.size()));
+
+    // 'a', 'b', 'c', 'd' and 'r' use codes 1..5, so the alphabet is 6 and codes take 3 bits
+    std::vector<FMIndex::word_type> bad_bits_count = words;
+    ASSERT_EQ(bad_bits_count[3], 6u);
+    ASSERT_EQ(bad_bits_count[4], 3u);
+    // one more level takes a zeros count and a bitvector of 9 words, keep the sizes consistent
+    bad_bits_count[4] = 4;
+    bad_bits_count[1] += 10;
+    bad_bits_count.resize(bad_bits_count[1], 0);
+    ASSERT_FALSE(index.attach(bad_bits_count.data(), bad_bits_count.size()));
+
+    std::vector<FMIndex::word_type> bad_code = words;
+    bad_code[FMIndex::kHeaderSize + 'z'] = 6;
+    ASSERT_FALSE(index.attach(bad_code.data(), bad_code.size()));
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(bad_code.data(), sizeof(FMIndex::word_type), bad_code.size(), file), bad_code.size());
+    std::rewind(file);
+    ASSERT_FALSE(index.load(file));
+    std::fclose(file);
+    ASSERT_EQ(index.words_count(), 0u);
+
+    file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(std::fwrite(words.data(), sizeof(FMIndex::word_type), words.size() - 1, file), words.size() - 1);
+    std::rewind(file);
+    ASSERT_FALSE(index.load(file));
+    std::fclose(file);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/lazy_segment_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+struct Sum {
+    int64_t operator()(const int64_t a, const int64_t b) const {
+        return a + b;
+    }
+};
+
+struct ApplyAdd {
+    int64_t operator()(const int64_t value, const int64_t update, const size_t left, const size_t right) const {
+        return value + update * static_cast<int64_t>(right - left + 1);
+    }
+};
+
+using AddSumTree = LazySegmentTree<int64_t, Sum, int64_t, ApplyAdd, Sum>;
+
+constexpr int64_t kNoAssignment = std::numeric_limits<int64_t>::min();
+constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
+
+struct Min {
+    int64_t operator()(const int64_t a, const int64_t b) const {
+        return std::min(a, b);
+    }
+};
+
+struct ApplyAssign {
+    int64_t operator()(const int64_t value, const int64_t update, size_t, size_t) const {
+        return update == kNoAssignment ? value : update;
+    }
+};
+
+struct MergeAssignments {
+    int64_t operator()(const int64_t old_update, const int64_t new_update) const {
+        return new_update == kNoAssignment ? old_update : new_update;
+    }
+};
+
+using AssignMinTree = LazySegmentTree<int64_t, Min, int64_t, ApplyAssign, MergeAssignments>;
+
+template<typename Tree>
+std::vector<typename Tree::Operation> random_operations(const size_t elements_count, const size_t operations_count, const size_t window) {
+    // ranges are drawn from a window which moves slowly, so consecutive operations often form long runs
+    std::vector<typename Tree::Operation> operations;
+    size_t window_start = 0;
+    for (size_t i = 0; i < operations_count; ++i) {
+        if (Random::get<size_t>(0, 15) == 0) {
+            window_start = Random::get<size_t>(0, elements_count - 1);
+        }
+        const size_t window_end = std::min(elements_count - 1, window_start + window);
+        size_t left = Random::get<size_t>(window_start, window_end);
+        size_t right = Random::get<size_t>(window_start, window_end);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        operations.push_back({left, right, Random::get<size_t>(0, 1) == 0, Random::get<int64_t>(-100, 100)});
+    }
+    return operations;
+}
+
+template<typename Tree>
+void check_process(const std::vector<int64_t>& initial, const int64_t default_value, const int64_t default_update, const size_t window) {
+    const auto operations = random_operations<Tree>(initial.size(), 2000, window);
+    Tree single(initial.size(), default_value, {}, default_update);
+    Tree batch(initial.size(), default_value, {}, default_update);
+    single.build(initial);
+    batch.build(initial);
+
+    std::vector<int64_t> expected;
+    for (const auto& operation : operations) {
+        if (operation.is_query) {
+            expected.emplace_back(single.get(operation.left, operation.right));
+        } else {
+            single.range_update(operation.left, operation.right, operation.update);
+        }
+    }
+    std::vector<int64_t> results;
+    batch.process(operations, &results);
+    ASSERT_EQ(results, expected);
+    ASSERT_EQ(batch.get_all(), single.get_all());
+    for (size_t i = 0; i < initial.size(); ++i) {
+        ASSERT_EQ(batch.get(i), single.get(i));
+    }
+}
+
+}  // namespace
+
+TEST(LazySegmentTree, add_sum_matches_naive) {
+    for (const size_t n : {1, 2, 7, 64, 100}) {
+        AddSumTree tree(n);
+        std::vector<int64_t> a(n, 0);
+        for (size_t it = 0; it < 3000; ++it) {
+            size_t left = Random::get<size_t>(0, n - 1);
+            size_t right = Random::get<size_t>(0, n - 1);
+            if (left > right) {
+                std::swap(left, right);
+            }
+            if (Random::get<size_t>(0, 2) == 0) {
+                const int64_t delta = Random::get<int64_t>(-50, 50);
+                tree.range_update(left, right, delta);
+                for (size_t i = left; i <= right; ++i) {
+                    a[i] += delta;
+                }
+            } else if (Random::get<size_t>(0, 5) == 0) {
+                a[left] = Random::get<int64_t>(-50, 50);
+                tree.set(left, a[left]);
+            }
+            const AddSumTree& const_tree = tree;
+            int64_t sum = 0;
+            for (size_t i = left; i <= right; ++i) {
+                sum += a[i];
+            }
+            ASSERT_EQ(const_tree.get(left, right), sum);
+            ASSERT_EQ(const_tree.get(left), a[left]);
+        }
+    }
+}
+
+TEST(LazySegmentTree, process_matches_single_operations) {
+    for (const size_t n : {1, 5, 64, 1000}) {
+        std::vector<int64_t> initial(n);
+        for (auto& it : initial) {
+            it = Random::get<int64_t>(-1000, 1000);
+        }
+        for (const size_t window : {size_t(0), size_t(3), size_t(40), n}) {
+            check_process<AddSumTree>(initial, 0, 0, window);
+            check_process<AssignMinTree>(initial, kInfinity, kNoAssignment, window);
+        }
+    }
+}
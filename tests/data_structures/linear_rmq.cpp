@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/linear_rmq.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+template<typename Cmp>
+size_t naive_query(const std::vector<int64_t>& a, const size_t left, const size_t right, const Cmp& cmp) {
+    size_t result = left;
+    for (size_t i = left + 1; i < right; ++i) {
+        if (cmp(a[i], a[result])) {
+            result = i;
+        }
+    }
+    return result;
+}
+
+template<typename Cmp>
+void check_against_naive(const size_t n, const int64_t max_value, const size_t queries) {
+    std::vector<int64_t> a(n);
+    for (auto& it : a) {
+        it = Random::get<int64_t>(0, max_value);
+    }
+    const LinearRmqCmp<int64_t, Cmp> rmq(a);
+    ASSERT_EQ(rmq.size(), n);
+    for (size_t it = 0; it < queries; ++it) {
+        size_t left = Random::get<size_t>(0, n - 1);
+        size_t right = Random::get<size_t>(0, n - 1);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        // short ranges stay inside one or two blocks more often
+        if (it % 2 == 1) {
+            right = std::min(left + Random::get<size_t>(0, 70), n - 1);
+        }
+        ASSERT_EQ(rmq.query(left, right + 1), naive_query(a, left, right + 1, Cmp()));
+    }
+}
+
+}  // namespace
+
+TEST(LinearRmqCmp, minimum_matches_naive) {
+    for (const size_t n : {1, 2, 63, 64, 65, 128, 129, 1000, 5000}) {
+        check_against_naive<std::less<int64_t>>(n, 1000000, 2000);
+    }
+}
+
+TEST(LinearRmqCmp, ties_resolve_to_leftmost) {
+    for (const size_t n : {1, 64, 200, 3000}) {
+        check_against_naive<std::less<int64_t>>(n, 2, 2000);
+        check_against_naive<std::greater<int64_t>>(n, 2, 2000);
+    }
+}
+
+TEST(LinearRmqCmp, all_ranges_of_small_array) {
+    const size_t n = 300;
+    std::vector<int64_t> a(n);
+    for (auto& it : a) {
+        it = Random::get<int64_t>(0, 50);
+    }
+    const LinearRmqCmp<int64_t> rmq(a);
+    for (size_t left = 0; left < n; ++left) {
+        size_t expected = left;
+        for (size_t right = left + 1; right <= n; ++right) {
+            if (a[right - 1] < a[expected]) {
+                expected = right - 1;
+            }
+            ASSERT_EQ(rmq.query(left, right), expected);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/persistent_segment_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+struct Sum {
+    int64_t operator()(const int64_t a, const int64_t b) const {
+        return a + b;
+    }
+};
+
+using Tree = PersistentSegmentTree<int64_t, Sum>;
+
+}  // namespace
+
+TEST(PersistentSegmentTree, versions_match_naive) {
+    for (const size_t n : {1, 2, 7, 64, 100}) {
+        Tree tree(n);
+        std::vector<int64_t> initial(n);
+        for (auto& it : initial) {
+            it = Random::get<int64_t>(-100, 100);
+        }
+        std::vector<Tree::version_type> versions{Tree::kEmptyVersion, tree.build(initial)};
+        std::vector<std::vector<int64_t>> arrays{std::vector<int64_t>(n, 0), initial};
+        for (size_t it = 0; it < 500; ++it) {
+            const size_t base = Random::get<size_t>(0, versions.size() - 1);
+            const size_t position = Random::get<size_t>(0, n - 1);
+            const int64_t value = Random::get<int64_t>(-100, 100);
+            std::vector<int64_t> array = arrays[base];
+            if (Random::get<size_t>(0, 1) == 0) {
+                versions.emplace_back(tree.set(versions[base], position, value));
+                array[position] = value;
+            } else {
+                versions.emplace_back(tree.add(versions[base], position, value));
+                array[position] += value;
+            }
+            arrays.emplace_back(std::move(array));
+
+            const size_t checked = Random::get<size_t>(0, versions.size() - 1);
+            size_t left = Random::get<size_t>(0, n - 1);
+            size_t right = Random::get<size_t>(0, n - 1);
+            if (left > right) {
+                std::swap(left, right);
+            }
+            int64_t sum = 0;
+            for (size_t i = left; i <= right; ++i) {
+                sum += arrays[checked][i];
+            }
+            ASSERT_EQ(tree.query(versions[checked], left, right), sum);
+            ASSERT_EQ(tree.get(versions[checked], left), arrays[checked][left]);
+        }
+        for (size_t v = 0; v < versions.size(); ++v) {
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(tree.get(versions[v], i), arrays[v][i]);
+            }
+        }
+    }
+}
+
+TEST(PersistentSegmentTree, kth_smallest_on_subarrays) {
+    const size_t n = 200;
+    const size_t values_count = 50;
+    std::vector<int64_t> a(n);
+    for (auto& it : a) {
+        it = Random::get<int64_t>(0, values_count - 1);
+    }
+    Tree tree(values_count);
+    tree.reserve(2 * values_count + n * 8);
+    // version i holds the counts of values among the first i elements
+    std::vector<Tree::version_type> versions{Tree::kEmptyVersion};
+    for (const int64_t value : a) {
+        versions.emplace_back(tree.add(versions.back(), value, 1));
+    }
+    for (size_t it = 0; it < 500; ++it) {
+        size_t from = Random::get<size_t>(0, n - 1);
+        size_t to = Random::get<size_t>(0, n - 1);
+        if (from > to) {
+            std::swap(from, to);
+        }
+        ++to;
+        std::vector<int64_t> sorted(a.begin() + from, a.begin() + to);
+        std::sort(sorted.begin(), sorted.end());
+        const size_t k = Random::get<size_t>(0, sorted.size());
+        const size_t expected = (k < sorted.size() ? sorted[k] : values_count);
+        ASSERT_EQ(tree.kth(versions[from], versions[to], k), expected);
+    }
+    ASSERT_EQ(tree.kth(versions[n], 0), static_cast<size_t>(*std::min_element(a.begin(), a.end())));
+}
+
+TEST(PersistentSegmentTree, empty_tree) {
+    Tree tree(0);
+    const Tree::version_type version = tree.build(std::vector<int64_t>());
+    ASSERT_EQ(tree.query_all(version), 0);
+    ASSERT_EQ(tree.get(version, 0), 0);
+    ASSERT_EQ(tree.query(version, 0, 0), 0);
+}
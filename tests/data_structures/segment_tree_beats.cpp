@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/segment_tree_beats.hpp"
+#include "maths/random.hpp"
+
+TEST(SegmentTreeBeats, random_operations_match_naive) {
+    for (size_t test = 0; test < 300; ++test) {
+        const size_t n = Random::get<size_t>(1, 40);
+        std::vector<int64_t> a(n);
+        for (auto& it : a) {
+            it = Random::get<int64_t>(-20, 20);
+        }
+        SegmentTreeBeats<int64_t> tree(a.begin(), a.end());
+        for (size_t it = 0; it < 300; ++it) {
+            size_t left = Random::get<size_t>(0, n - 1);
+            size_t right = Random::get<size_t>(0, n - 1);
+            if (left > right) {
+                std::swap(left, right);
+            }
+            const int64_t value = Random::get<int64_t>(-20, 20);
+            switch (Random::get<int>(0, 3)) {
+                case 0:
+                    tree.chmin(left, right, value);
+                    for (size_t i = left; i <= right; ++i) {
+                        a[i] = std::min(a[i], value);
+                    }
+                    break;
+                case 1:
+                    tree.chmax(left, right, value);
+                    for (size_t i = left; i <= right; ++i) {
+                        a[i] = std::max(a[i], value);
+                    }
+                    break;
+                case 2:
+                    tree.add(left, right, value);
+                    for (size_t i = left; i <= right; ++i) {
+                        a[i] += value;
+                    }
+                    break;
+                default:
+                    tree.set(left, value);
+                    a[left] = value;
+                    break;
+            }
+            size_t query_left = Random::get<size_t>(0, n - 1);
+            size_t query_right = Random::get<size_t>(0, n - 1);
+            if (query_left > query_right) {
+                std::swap(query_left, query_right);
+            }
+            int64_t sum = 0;
+            for (size_t i = query_left; i <= query_right; ++i) {
+                sum += a[i];
+            }
+            ASSERT_EQ(tree.sum(query_left, query_right), sum);
+            ASSERT_EQ(tree.max(query_left, query_right),
+                      *std::max_element(a.begin() + query_left, a.begin() + query_right + 1));
+            ASSERT_EQ(tree.min(query_left, query_right),
+                      *std::min_element(a.begin() + query_left, a.begin() + query_right + 1));
+            ASSERT_EQ(tree.get(query_left), a[query_left]);
+        }
+    }
+}
+
+TEST(SegmentTreeBeats, wide_sum_type) {
+    SegmentTreeBeats<int, int64_t> tree(std::vector<int>(5, 1000000000));
+    ASSERT_EQ(tree.sum(0, 4), 5000000000LL);
+    tree.chmin(1, 3, 7);
+    ASSERT_EQ(tree.sum(0, 4), 2000000021LL);
+    tree.chmax(0, 4, 10);
+    ASSERT_EQ(tree.sum(0, 4), 2000000030LL);
+    ASSERT_EQ(tree.min(0, 4), 10);
+    ASSERT_EQ(tree.max(1, 3), 10);
+}
+
+TEST(SegmentTreeBeats, empty_tree) {
+    SegmentTreeBeats<int64_t> tree(0);
+    ASSERT_EQ(tree.elements_count(), 0u);
+    tree.chmin(0, 0, 1);
+    tree.add(0, 0, 1);
+    ASSERT_EQ(tree.sum(0, 0), 0);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "cpplib/data_structures/suffix_array.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+template<typename Char>
+std::vector<SuffixArraySais::index_type> naive_suffix_array(const std::vector<Char>& s) {
+    std::vector<SuffixArraySais::index_type> sa(s.size());
+    std::iota(sa.begin(), sa.end(), 0);
+    std::sort(sa.begin(), sa.end(), [&](const SuffixArraySais::index_type a, const SuffixArraySais::index_type b) {
+        return std::lexicographical_compare(s.begin() + a, s.end(), s.begin() + b, s.end());
+    });
+    return sa;
+}
+
+std::string random_string(const size_t n, const char max_char) {
+    std::string s(n, 'a');
+    for (auto& it : s) {
+        it = static_cast<char>(Random::get<int>('a', max_char));
+    }
+    return s;
+}
+
+}  // namespace
+
+TEST(SuffixArraySais, strings_match_naive) {
+    SuffixArraySais builder;
+    for (const char max_char : {'a', 'b', 'c', 'z'}) {
+        for (size_t it = 0; it < 300; ++it) {
+            const std::string s = random_string(Random::get<size_t>(0, 200), max_char);
+            std::vector<SuffixArraySais::index_type> sa;
+            ASSERT_TRUE(builder.build(s, &sa));
+            ASSERT_EQ(sa, naive_suffix_array(std::vector<char>(s.begin(), s.end())));
+        }
+    }
+}
+
+TEST(SuffixArraySais, periodic_strings) {
+    SuffixArraySais builder;
+    for (const char* period : {"a", "ab", "aab", "abaab", "abcabd"}) {
+        std::string s;
+        while (s.length() < 300) {
+            s += period;
+            std::vector<SuffixArraySais::index_type> sa;
+            ASSERT_TRUE(builder.build(s, &sa));
+            ASSERT_EQ(sa, naive_suffix_array(std::vector<char>(s.begin(), s.end())));
+        }
+    }
+}
+
+TEST(SuffixArraySais, chars_above_127_are_unsigned) {
+    const std::string s = "\xff\x01\x80\x7f\xff\x80";
+    std::vector<SuffixArraySais::index_type> sa;
+    ASSERT_TRUE(SuffixArraySais().build(s, &sa));
+    ASSERT_EQ(sa, naive_suffix_array(std::vector<unsigned char>(s.begin(), s.end())));
+}
+
+TEST(SuffixArraySais, integer_alphabet) {
+    SuffixArraySais builder;
+    for (const int32_t alphabet : {1, 2, 1000, 100000}) {
+        for (size_t it = 0; it < 50; ++it) {
+            std::vector<int32_t> s(Random::get<size_t>(1, 2000));
+            for (auto& c : s) {
+                c = Random::get<int32_t>(0, alphabet - 1);
+            }
+            std::vector<SuffixArraySais::index_type> sa(s.size());
+            builder.build(s.data(), static_cast<SuffixArraySais::index_type>(s.size()), alphabet, sa.data());
+            ASSERT_EQ(sa, naive_suffix_array(s));
+        }
+    }
+}
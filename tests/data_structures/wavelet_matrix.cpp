@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/wavelet_matrix.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+template<typename T>
+void check_against_naive(const std::vector<T>& a, const T max_value, const size_t queries) {
+    const WaveletMatrix<T> matrix(a);
+    const size_t n = a.size();
+    ASSERT_EQ(matrix.size(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(matrix.access(i), a[i]);
+    }
+    for (size_t it = 0; it < queries; ++it) {
+        size_t left = Random::get<size_t>(0, n);
+        size_t right = Random::get<size_t>(0, n);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        T lower = Random::get<T>(0, max_value);
+        T upper = Random::get<T>(0, max_value);
+        if (lower > upper) {
+            std::swap(lower, upper);
+        }
+        std::vector<T> sorted(a.begin() + left, a.begin() + right);
+        std::sort(sorted.begin(), sorted.end());
+
+        const size_t less = std::lower_bound(sorted.begin(), sorted.end(), upper) - sorted.begin();
+        ASSERT_EQ(matrix.count_less(left, right, upper), less);
+        ASSERT_EQ(matrix.range_freq(left, right, lower, upper),
+                  less - (std::lower_bound(sorted.begin(), sorted.end(), lower) - sorted.begin()));
+        if (!sorted.empty()) {
+            const size_t k = Random::get<size_t>(0, sorted.size() - 1);
+            ASSERT_EQ(matrix.kth_smallest(left, right, k), sorted[k]);
+            ASSERT_EQ(matrix.kth_largest(left, right, k), sorted[sorted.size() - 1 - k]);
+        }
+
+        T result = 0;
+        ASSERT_EQ(matrix.prev_value(left, right, upper, &result), less > 0);
+        if (less > 0) {
+            ASSERT_EQ(result, sorted[less - 1]);
+        }
+        const size_t not_less = std::lower_bound(sorted.begin(), sorted.end(), lower) - sorted.begin();
+        ASSERT_EQ(matrix.next_value(left, right, lower, &result), not_less < sorted.size());
+        if (not_less < sorted.size()) {
+            ASSERT_EQ(result, sorted[not_less]);
+        }
+
+        const T value = (n > 0 && Random::get<int>(0, 1) == 0 ? a[Random::get<size_t>(0, n - 1)] : lower);
+        ASSERT_EQ(matrix.rank(value, right), static_cast<size_t>(std::count(a.begin(), a.begin() + right, value)));
+        const size_t k = Random::get<size_t>(0, 3);
+        size_t expected = n;
+        for (size_t i = 0, seen = 0; i < n; ++i) {
+            if (a[i] == value && seen++ == k) {
+                expected = i;
+                break;
+            }
+        }
+        ASSERT_EQ(matrix.select(value, k), expected);
+    }
+}
+
+}  // namespace
+
+TEST(WaveletMatrix, small_alphabet_matches_naive) {
+    for (const size_t n : {0, 1, 2, 10, 100, 1000}) {
+        for (const uint32_t max_value : {0u, 1u, 7u, 100u}) {
+            std::vector<uint32_t> a(n);
+            for (auto& it : a) {
+                it = Random::get<uint32_t>(0, max_value);
+            }
+            check_against_naive(a, max_value, 300);
+        }
+    }
+}
+
+TEST(WaveletMatrix, full_width_values) {
+    const uint64_t max_value = std::numeric_limits<uint64_t>::max();
+    std::vector<uint64_t> a(500);
+    for (auto& it : a) {
+        it = (Random::get<int>(0, 1) == 0 ? max_value - Random::get<uint64_t>(0, 5) : Random::get<uint64_t>(0, max_value));
+    }
+    check_against_naive(a, max_value, 300);
+}
+
+TEST(WaveletMatrix, values_above_bits_count_are_absent) {
+    const WaveletMatrix<uint32_t> matrix(std::vector<uint32_t>{1, 3, 2, 3}, 2);
+    ASSERT_EQ(matrix.bits_count(), 2u);
+    ASSERT_EQ(matrix.rank(4, 4), 0u);
+    ASSERT_EQ(matrix.select(7, 0), 4u);
+    ASSERT_EQ(matrix.count_less(0, 4, 100), 4u);
+    ASSERT_EQ(matrix.range_freq(0, 4, 2, 100), 3u);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpplib/data_structures/segment_tree/wide_segment_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+struct Concatenate {
+    std::string operator()(const std::string& a, const std::string& b) const {
+        return a + b;
+    }
+};
+
+struct Sum {
+    int64_t operator()(const int64_t a, const int64_t b) const {
+        return a + b;
+    }
+};
+
+template<size_t B>
+void check_concatenation(const size_t n) {
+    std::vector<std::string> a(n);
+    for (auto& it : a) {
+        it = std::string(1, static_cast<char>('a' + Random::get<int>(0, 25)));
+    }
+    WideSegmentTree<std::string, Concatenate, B> tree(a.begin(), a.end(), Concatenate(), "");
+    for (size_t it = 0; it < 300; ++it) {
+        if (Random::get<size_t>(0, 1) == 0) {
+            const size_t position = Random::get<size_t>(0, n - 1);
+            a[position] = std::string(1, static_cast<char>('a' + Random::get<int>(0, 25)));
+            tree.update(position, a[position]);
+        }
+        size_t left = Random::get<size_t>(0, n - 1);
+        size_t right = Random::get<size_t>(0, n - 1);
+        if (left > right) {
+            std::swap(left, right);
+        }
+        std::string expected;
+        for (size_t i = left; i <= right; ++i) {
+            expected += a[i];
+        }
+        ASSERT_EQ(tree.query(left, right), expected);
+        ASSERT_EQ(tree.get(left), a[left]);
+    }
+}
+
+}  // namespace
+
+TEST(WideSegmentTree, non_commutative_merge_matches_naive) {
+    for (const size_t n : {1, 2, 3, 15, 16, 17, 100, 300}) {
+        check_concatenation<2>(n);
+        check_concatenation<3>(n);
+        check_concatenation<4>(n);
+        check_concatenation<16>(n);
+    }
+}
+
+TEST(WideSegmentTree, sums_of_large_tree) {
+    const size_t n = 70000;
+    std::vector<int64_t> a(n);
+    for (auto& it : a) {
+        it = Random::get<int64_t>(-1000, 1000);
+    }
+    WideSegmentTree<int64_t, Sum> tree(a.begin(), a.end());
+    ASSERT_GE(tree.layers_count(), 4u);
+    std::vector<int64_t> prefix(n + 1, 0);
+    for (size_t it = 0; it < 2000; ++it) {
+        const size_t position = Random::get<size_t>(0, n - 1);
+        a[position] = Random::get<int64_t>(-1000, 1000);
+        tree.update(position, a[position]);
+        if (it % 100 == 0) {
+            for (size_t i = 0; i < n; ++i) {
+                prefix[i + 1] = prefix[i] + a[i];
+            }
+            for (size_t q = 0; q < 100; ++q) {
+                size_t left = Random::get<size_t>(0, n - 1);
+                size_t right = Random::get<size_t>(0, n - 1);
+                if (left > right) {
+                    std::swap(left, right);
+                }
+                ASSERT_EQ(tree.query(left, right), prefix[right + 1] - prefix[left]);
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "cpplib/graph/2_sat.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+using Clause = std::pair<size_t, size_t>;
+
+bool is_true(const size_t mask, const size_t literal) {
+    return ((mask >> (literal >> 1)) & 1) != (literal & 1);
+}
+
+bool brute_force_satisfiable(const size_t variables_count, const std::vector<Clause>& clauses) {
+    for (size_t mask = 0; mask < (size_t(1) << variables_count); ++mask) {
+        bool satisfied = true;
+        for (const auto& clause : clauses) {
+            satisfied = satisfied && (is_true(mask, clause.first) || is_true(mask, clause.second));
+        }
+        if (satisfied) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(TwoSatSolver, incremental_matches_brute_force) {
+    for (size_t test = 0; test < 300; ++test) {
+        const size_t variables_count = Random::get<size_t>(1, 8);
+        const size_t clauses_count = Random::get<size_t>(1, 3 * variables_count);
+        TwoSatSolver solver(variables_count);
+        std::vector<Clause> clauses;
+        for (size_t i = 0; i < clauses_count; ++i) {
+            const size_t a = Random::get<size_t>(0, 2 * variables_count - 1);
+            const size_t b = Random::get<size_t>(0, 2 * variables_count - 1);
+            clauses.emplace_back(a, b);
+            solver.add_or(a, b);
+            const bool satisfiable = solver.solve();
+            ASSERT_EQ(satisfiable, brute_force_satisfiable(variables_count, clauses));
+            if (!satisfiable) {
+                break;
+            }
+            for (const auto& clause : clauses) {
+                ASSERT_TRUE(solver.is_true(clause.first) || solver.is_true(clause.second));
+            }
+        }
+    }
+}
+
+TEST(TwoSatSolver, at_most_one) {
+    for (size_t count = 0; count <= 6; ++count) {
+        for (size_t forced_mask = 0; forced_mask < (size_t(1) << count); ++forced_mask) {
+            TwoSatSolver solver(count);
+            std::vector<size_t> literals;
+            for (size_t v = 0; v < count; ++v) {
+                literals.emplace_back(TwoSatSolver::positive(v));
+                if ((forced_mask >> v) & 1) {
+                    solver.set_value(TwoSatSolver::positive(v));
+                }
+            }
+            solver.at_most_one(literals);
+            size_t forced_count = 0;
+            for (size_t v = 0; v < count; ++v) {
+                forced_count += (forced_mask >> v) & 1;
+            }
+            ASSERT_EQ(solver.solve(), forced_count <= 1);
+            if (forced_count <= 1) {
+                size_t true_count = 0;
+                for (size_t v = 0; v < count; ++v) {
+                    true_count += solver.value(v);
+                }
+                ASSERT_LE(true_count, 1u);
+                ASSERT_GE(true_count, forced_count);
+            }
+        }
+    }
+}
+
+TEST(TwoSatSolver, xor_and_equal) {
+    TwoSatSolver solver(3);
+    solver.add_xor(TwoSatSolver::positive(0), TwoSatSolver::positive(1));
+    solver.add_equal(TwoSatSolver::positive(1), TwoSatSolver::negative(2));
+    solver.set_value(TwoSatSolver::positive(2));
+    ASSERT_TRUE(solver.solve());
+    ASSERT_EQ(solver.assignment(), (std::vector<bool>{true, false, true}));
+    solver.set_value(TwoSatSolver::negative(0));
+    ASSERT_FALSE(solver.solve());
+}
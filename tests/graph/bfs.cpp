@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "cpplib/graph/bfs.hpp"
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/undirected_graph.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+template<typename Graph>
+std::vector<size_t> plain_bfs(const Graph& graph, const size_t start) {
+    std::vector<size_t> distance(graph.vertices_count(), BreadthFirstSearch::kUnreachable);
+    std::queue<size_t> queue;
+    distance[start] = 0;
+    queue.push(start);
+    while (!queue.empty()) {
+        const size_t v = queue.front();
+        queue.pop();
+        for (const size_t edge : graph.edges_list(v)) {
+            const size_t to = graph.to(edge);
+            if (distance[to] == BreadthFirstSearch::kUnreachable) {
+                distance[to] = distance[v] + 1;
+                queue.push(to);
+            }
+        }
+    }
+    return distance;
+}
+
+template<typename Graph>
+void check_bfs(const Graph& graph) {
+    std::set<std::pair<size_t, size_t>> edges;
+    for (const size_t v : graph.vertices()) {
+        for (const size_t edge : graph.edges_list(v)) {
+            edges.emplace(v, graph.to(edge));
+        }
+    }
+    for (const bool parallel : {false, true}) {
+        BreadthFirstSearch bfs(graph, parallel);
+        for (int i = 0; i < 5; ++i) {
+            const size_t start = Random::get<size_t>(0, graph.vertices_count() - 1);
+            bfs.run(start);
+            const std::vector<size_t> expected = plain_bfs(graph, start);
+            EXPECT_EQ(expected, bfs.distance());
+            EXPECT_EQ(start, bfs.parent()[start]);
+            for (const size_t v : graph.vertices()) {
+                if (v == start || !bfs.reachable(v)) {
+                    continue;
+                }
+                const size_t parent = bfs.parent()[v];
+                EXPECT_EQ(bfs.distance(v), bfs.distance(parent) + 1);
+                EXPECT_EQ(1U, edges.count(std::make_pair(parent, v)));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(BreadthFirstSearch, sparse_directed) {
+    const size_t kVertices = 2000;
+    DirectedGraph<> graph(kVertices);
+    for (size_t i = 0; i < 3 * kVertices; ++i) {
+        graph.add_directed_edge(Random::get<size_t>(0, kVertices - 1), Random::get<size_t>(0, kVertices - 1));
+    }
+    check_bfs(graph);
+}
+
+TEST(BreadthFirstSearch, dense_undirected) {
+    // dense enough for the frontier to switch to bottom-up steps
+    const size_t kVertices = 500;
+    UndirectedGraph<> graph(kVertices);
+    for (size_t i = 0; i < 20 * kVertices; ++i) {
+        graph.add_bidirectional_edge(Random::get<size_t>(0, kVertices - 1), Random::get<size_t>(0, kVertices - 1));
+    }
+    check_bfs(graph);
+}
+
+TEST(BreadthFirstSearch, dense_directed) {
+    const size_t kVertices = 500;
+    DirectedGraph<> graph(kVertices);
+    for (size_t i = 0; i < 30 * kVertices; ++i) {
+        graph.add_directed_edge(Random::get<size_t>(0, kVertices - 1), Random::get<size_t>(0, kVertices - 1));
+    }
+    check_bfs(graph);
+}
+
+TEST(BreadthFirstSearch, path_and_isolated_vertices) {
+    const size_t kVertices = 300;
+    UndirectedGraph<> graph(kVertices);
+    for (size_t v = 0; v + 1 < kVertices / 2; ++v) {
+        graph.add_bidirectional_edge(v, v + 1);
+    }
+    check_bfs(graph);
+}
+
+TEST(ConnectedComponents, labelled_components) {
+    for (const size_t edges_count : {0, 50, 200, 400, 2000}) {
+        const size_t kVertices = 400;
+        UndirectedGraph<> graph(kVertices);
+        for (size_t i = 0; i < edges_count; ++i) {
+            graph.add_bidirectional_edge(Random::get<size_t>(0, kVertices - 1), Random::get<size_t>(0, kVertices - 1));
+        }
+        std::vector<size_t> expected(kVertices, kVertices);
+        size_t components_count = 0;
+        for (const size_t v : graph.vertices()) {
+            if (expected[v] != kVertices) {
+                continue;
+            }
+            ++components_count;
+            const std::vector<size_t> distance = plain_bfs(graph, v);
+            for (const size_t u : graph.vertices()) {
+                if (distance[u] != BreadthFirstSearch::kUnreachable) {
+                    expected[u] = v;
+                }
+            }
+        }
+        EXPECT_EQ(expected, graph.labelled_components(false));
+        EXPECT_EQ(expected, graph.labelled_components(true));
+        EXPECT_EQ(components_count, graph.components_count());
+        EXPECT_EQ(components_count == 1, graph.is_connected());
+    }
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/graph_coloring.hpp"
+#include "cpplib/graph/max_clique.hpp"
+#include "cpplib/graph/undirected_graph.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+template<typename Graph>
+std::vector<std::vector<bool>> adjacency_matrix(const Graph& graph) {
+    // an edge in either direction makes two vertices adjacent, self-loops are ignored
+    std::vector<std::vector<bool>> adjacent(graph.vertices_count(), std::vector<bool>(graph.vertices_count(), false));
+    for (const size_t v : graph.vertices()) {
+        for (const size_t edge : graph.edges_list(v)) {
+            const size_t to = graph.to(edge);
+            if (to != v) {
+                adjacent[v][to] = adjacent[to][v] = true;
+            }
+        }
+    }
+    return adjacent;
+}
+
+bool is_clique(const std::vector<std::vector<bool>>& adjacent, const std::vector<size_t>& vertices) {
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        for (size_t j = i + 1; j < vertices.size(); ++j) {
+            if (!adjacent[vertices[i]][vertices[j]]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t brute_force_clique(const std::vector<std::vector<bool>>& adjacent) {
+    const size_t vertices_count = adjacent.size();
+    size_t result = 0;
+    for (size_t mask = 0; mask < (size_t(1) << vertices_count); ++mask) {
+        std::vector<size_t> vertices;
+        for (size_t v = 0; v < vertices_count; ++v) {
+            if ((mask >> v) & 1) {
+                vertices.emplace_back(v);
+            }
+        }
+        if (vertices.size() > result && is_clique(adjacent, vertices)) {
+            result = vertices.size();
+        }
+    }
+    return result;
+}
+
+bool colorable(const std::vector<std::vector<bool>>& adjacent, std::vector<size_t>& color, const size_t v, const size_t colors_count) {
+    if (v == adjacent.size()) {
+        return true;
+    }
+    for (size_t c = 0; c < colors_count; ++c) {
+        bool free = true;
+        for (size_t u = 0; u < v; ++u) {
+            free = free && !(adjacent[v][u] && color[u] == c);
+        }
+        if (free) {
+            color[v] = c;
+            if (colorable(adjacent, color, v + 1, colors_count)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+size_t brute_force_chromatic_number(const std::vector<std::vector<bool>>& adjacent) {
+    std::vector<size_t> color(adjacent.size());
+    size_t colors_count = 0;
+    while (!colorable(adjacent, color, 0, colors_count)) {
+        ++colors_count;
+    }
+    return colors_count;
+}
+
+template<typename Graph>
+void check_graph(const Graph& graph, const bool exact) {
+    const auto adjacent = adjacency_matrix(graph);
+    std::vector<size_t> clique;
+    const size_t clique_size = MaximumClique()(graph, &clique);
+    ASSERT_EQ(clique.size(), clique_size);
+    std::vector<size_t> sorted = clique;
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    ASSERT_TRUE(is_clique(adjacent, clique));
+
+    std::vector<size_t> color;
+    const size_t colors_count = DsaturColoring()(graph, &color);
+    ASSERT_EQ(color.size(), graph.vertices_count());
+    for (size_t v = 0; v < color.size(); ++v) {
+        ASSERT_LT(color[v], colors_count);
+        for (size_t u = 0; u < color.size(); ++u) {
+            ASSERT_FALSE(adjacent[v][u] && color[v] == color[u]);
+        }
+    }
+    ASSERT_EQ(colors_count, color.empty() ? 0 : *std::max_element(color.begin(), color.end()) + 1);
+    ASSERT_GE(colors_count, clique_size);
+
+    if (exact) {
+        ASSERT_EQ(clique_size, brute_force_clique(adjacent));
+        ASSERT_GE(colors_count, brute_force_chromatic_number(adjacent));
+    }
+}
+
+}  // namespace
+
+TEST(MaximumClique, small_graphs_match_brute_force) {
+    for (size_t test = 0; test < 300; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 12);
+        const size_t edges_count = Random::get<size_t>(0, vertices_count * (vertices_count - 1) / 2 + 5);
+        UndirectedGraph<> undirected(vertices_count);
+        DirectedGraph<> directed(vertices_count);
+        for (size_t i = 0; i < edges_count; ++i) {
+            const size_t from = Random::get<size_t>(0, vertices_count - 1);
+            const size_t to = Random::get<size_t>(0, vertices_count - 1);
+            undirected.add_bidirectional_edge(from, to);
+            directed.add_directed_edge(from, to);
+        }
+        check_graph(undirected, true);
+        check_graph(directed, true);
+    }
+}
+
+TEST(MaximumClique, planted_clique_in_multiword_graph) {
+    for (const size_t vertices_count : {63, 64, 65, 130, 200}) {
+        UndirectedGraph<> graph(vertices_count);
+        for (size_t i = 0; i < vertices_count * 3; ++i) {
+            graph.add_bidirectional_edge(Random::get<size_t>(0, vertices_count - 1), Random::get<size_t>(0, vertices_count - 1));
+        }
+        std::vector<size_t> planted;
+        while (planted.size() < 12) {
+            const size_t v = Random::get<size_t>(0, vertices_count - 1);
+            if (std::find(planted.begin(), planted.end(), v) == planted.end()) {
+                planted.emplace_back(v);
+            }
+        }
+        for (size_t i = 0; i < planted.size(); ++i) {
+            for (size_t j = i + 1; j < planted.size(); ++j) {
+                graph.add_bidirectional_edge(planted[i], planted[j]);
+            }
+        }
+        check_graph(graph, false);
+        ASSERT_GE(MaximumClique()(graph), planted.size());
+    }
+}
+
+TEST(DsaturColoring, exact_on_bipartite_and_complete_graphs) {
+    UndirectedGraph<> bipartite(40);
+    for (size_t i = 0; i < 200; ++i) {
+        bipartite.add_bidirectional_edge(2 * Random::get<size_t>(0, 19), 2 * Random::get<size_t>(0, 19) + 1);
+    }
+    ASSERT_LE(DsaturColoring()(bipartite), 2u);
+
+    UndirectedGraph<> complete(70);
+    for (size_t u = 0; u < 70; ++u) {
+        for (size_t v = u + 1; v < 70; ++v) {
+            complete.add_bidirectional_edge(u, v);
+        }
+    }
+    ASSERT_EQ(DsaturColoring()(complete), 70u);
+    ASSERT_EQ(MaximumClique()(complete), 70u);
+}
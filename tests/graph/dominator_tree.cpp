@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/dominator_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+std::vector<bool> reachable_without(const DirectedGraph<>& graph, const size_t root, const size_t removed) {
+    std::vector<bool> visited(graph.vertices_count(), false);
+    if (root == removed) {
+        return visited;
+    }
+    std::vector<size_t> stack{root};
+    visited[root] = true;
+    while (!stack.empty()) {
+        const size_t v = stack.back();
+        stack.pop_back();
+        for (const size_t edge : graph.edges_list(v)) {
+            const size_t to = graph.to(edge);
+            if (to != removed && !visited[to]) {
+                visited[to] = true;
+                stack.emplace_back(to);
+            }
+        }
+    }
+    return visited;
+}
+
+std::vector<size_t> brute_force_idom(const DirectedGraph<>& graph, const size_t root) {
+    // d dominates v if v is unreachable once d is removed; idom(v) is the strict dominator with the most dominators
+    const size_t vertices_count = graph.vertices_count();
+    const std::vector<bool> reachable = reachable_without(graph, root, vertices_count);
+    std::vector<std::vector<bool>> dominates(vertices_count);
+    for (size_t d = 0; d < vertices_count; ++d) {
+        const std::vector<bool> visited = reachable_without(graph, root, d);
+        dominates[d].resize(vertices_count);
+        for (size_t v = 0; v < vertices_count; ++v) {
+            dominates[d][v] = reachable[v] && !visited[v];
+        }
+    }
+    std::vector<size_t> dominators_count(vertices_count, 0);
+    for (size_t d = 0; d < vertices_count; ++d) {
+        for (size_t v = 0; v < vertices_count; ++v) {
+            dominators_count[v] += dominates[d][v];
+        }
+    }
+    std::vector<size_t> idom(vertices_count, DominatorTree::kUndefinedVertex);
+    idom[root] = root;
+    for (size_t v = 0; v < vertices_count; ++v) {
+        if (v == root || !reachable[v]) {
+            continue;
+        }
+        for (size_t d = 0; d < vertices_count; ++d) {
+            if (d != v && dominates[d][v] && dominators_count[d] + 1 == dominators_count[v]) {
+                idom[v] = d;
+            }
+        }
+    }
+    return idom;
+}
+
+}  // namespace
+
+TEST(DominatorTree, matches_brute_force) {
+    for (size_t test = 0; test < 300; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 12);
+        const size_t edges_count = Random::get<size_t>(0, 3 * vertices_count);
+        DirectedGraph<> graph(vertices_count);
+        for (size_t i = 0; i < edges_count; ++i) {
+            graph.add_directed_edge(Random::get<size_t>(0, vertices_count - 1), Random::get<size_t>(0, vertices_count - 1));
+        }
+        const size_t root = Random::get<size_t>(0, vertices_count - 1);
+        const DominatorTree tree(graph, root);
+        const std::vector<size_t> expected = brute_force_idom(graph, root);
+        ASSERT_EQ(tree.idom(), expected);
+
+        std::vector<bool> seen(vertices_count, false);
+        for (const size_t v : tree.preorder()) {
+            ASSERT_TRUE(tree.reachable(v));
+            ASSERT_TRUE(v == root || seen[tree.idom(v)]);
+            seen[v] = true;
+        }
+        for (size_t v = 0; v < vertices_count; ++v) {
+            ASSERT_EQ(tree.reachable(v), expected[v] != DominatorTree::kUndefinedVertex);
+        }
+    }
+}
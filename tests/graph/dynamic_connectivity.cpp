@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "cpplib/graph/dynamic_connectivity.hpp"
+#include "cpplib/graph/rollback_dsu.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+std::vector<size_t> component_labels(const size_t vertices_count, const std::map<std::pair<size_t, size_t>, size_t>& edges) {
+    std::vector<size_t> label(vertices_count);
+    for (size_t v = 0; v < vertices_count; ++v) {
+        label[v] = v;
+    }
+    // minimum label propagation until nothing changes, every vertex gets the minimal id of its component
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (const auto& edge : edges) {
+            const size_t a = edge.first.first;
+            const size_t b = edge.first.second;
+            if (label[a] != label[b]) {
+                label[a] = label[b] = std::min(label[a], label[b]);
+                changed = true;
+            }
+        }
+    }
+    return label;
+}
+
+}  // namespace
+
+TEST(OfflineDynamicConnectivity, matches_brute_force) {
+    for (size_t test = 0; test < 100; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 10);
+        OfflineDynamicConnectivity connectivity(vertices_count);
+        std::map<std::pair<size_t, size_t>, size_t> edges;
+        std::vector<bool> is_connected_query;
+        std::vector<size_t> expected;
+        std::vector<size_t> query_ids;
+        const size_t events_count = Random::get<size_t>(0, 200);
+        for (size_t i = 0; i < events_count; ++i) {
+            const size_t a = Random::get<size_t>(0, vertices_count - 1);
+            const size_t b = Random::get<size_t>(0, vertices_count - 1);
+            const auto edge = std::make_pair(std::min(a, b), std::max(a, b));
+            const size_t type = Random::get<size_t>(0, 3);
+            if (type == 0) {
+                connectivity.add_edge(a, b);
+                ++edges[edge];
+            } else if (type == 1) {
+                const bool present = (edges.count(edge) > 0);
+                ASSERT_EQ(connectivity.remove_edge(b, a), present);
+                if (present && --edges[edge] == 0) {
+                    edges.erase(edge);
+                }
+            } else {
+                const std::vector<size_t> label = component_labels(vertices_count, edges);
+                if (type == 2) {
+                    query_ids.emplace_back(connectivity.query_connected(a, b));
+                    expected.emplace_back(label[a] == label[b]);
+                } else {
+                    query_ids.emplace_back(connectivity.query_components_count());
+                    size_t count = 0;
+                    for (size_t v = 0; v < vertices_count; ++v) {
+                        count += (label[v] == v);
+                    }
+                    expected.emplace_back(count);
+                }
+                is_connected_query.emplace_back(type == 2);
+            }
+        }
+        connectivity.solve();
+        ASSERT_EQ(connectivity.queries_count(), query_ids.size());
+        for (size_t i = 0; i < query_ids.size(); ++i) {
+            if (is_connected_query[i]) {
+                ASSERT_EQ(connectivity.connected(query_ids[i]), expected[i] != 0);
+            } else {
+                ASSERT_EQ(connectivity.components_count(query_ids[i]), expected[i]);
+            }
+        }
+    }
+}
+
+TEST(RollbackDSU, rollback_restores_sets) {
+    RollbackDSU dsu(6);
+    ASSERT_TRUE(dsu.unite(0, 1));
+    const size_t snapshot = dsu.snapshot();
+    ASSERT_TRUE(dsu.unite(1, 2));
+    ASSERT_TRUE(dsu.unite(3, 4));
+    ASSERT_FALSE(dsu.unite(0, 2));
+    ASSERT_EQ(dsu.sets_count(), 3u);
+    ASSERT_EQ(dsu.set_size(2), 3u);
+    dsu.rollback(snapshot);
+    ASSERT_EQ(dsu.sets_count(), 5u);
+    ASSERT_EQ(dsu.find_set(0), dsu.find_set(1));
+    ASSERT_NE(dsu.find_set(1), dsu.find_set(2));
+    ASSERT_NE(dsu.find_set(3), dsu.find_set(4));
+    ASSERT_EQ(dsu.set_size(0), 2u);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/eulerian_path.h"
+#include "cpplib/graph/undirected_graph.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+size_t pair_id(const bool directed, const size_t edge) {
+    return directed ? edge : (edge >> 1);
+}
+
+template<typename Graph>
+size_t real_edges_count(const Graph& graph) {
+    return graph.edges_count() / (graph.is_directed() ? 1 : 2);
+}
+
+template<typename Graph>
+bool extend_trail(const Graph& graph, const size_t v, const size_t remaining, const bool cycle, const size_t start, std::vector<bool>& used) {
+    if (remaining == 0) {
+        return !cycle || v == start;
+    }
+    for (const size_t edge : graph.edges_list(v)) {
+        const size_t id = pair_id(graph.is_directed(), edge);
+        if (used[id]) {
+            continue;
+        }
+        used[id] = true;
+        const bool found = extend_trail(graph, graph.to(edge), remaining - 1, cycle, start, used);
+        used[id] = false;
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Graph>
+bool brute_force_exists(const Graph& graph, const bool cycle) {
+    const size_t edges_count = real_edges_count(graph);
+    if (edges_count == 0) {
+        return true;
+    }
+    std::vector<bool> used(edges_count, false);
+    for (const size_t v : graph.vertices()) {
+        if (extend_trail(graph, v, edges_count, cycle, v, used)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Graph>
+void check_trail(const Graph& graph, const std::vector<size_t>& trail, std::vector<bool>& used) {
+    ASSERT_FALSE(trail.empty());
+    for (size_t i = 0; i < trail.size(); ++i) {
+        ASSERT_LT(trail[i], graph.edges_count());
+        const size_t id = pair_id(graph.is_directed(), trail[i]);
+        ASSERT_FALSE(used[id]);
+        used[id] = true;
+        if (i > 0) {
+            ASSERT_EQ(graph.from(trail[i]), graph.to(trail[i - 1]));
+        }
+    }
+}
+
+template<typename Graph>
+void check_graph(const Graph& graph) {
+    const size_t edges_count = real_edges_count(graph);
+    EulerianPath eulerian_path;
+    for (const bool cycle : {false, true}) {
+        std::vector<size_t> path;
+        const bool found = eulerian_path(graph, &path, cycle);
+        ASSERT_EQ(found, brute_force_exists(graph, cycle));
+        if (!found) {
+            continue;
+        }
+        ASSERT_EQ(path.size(), edges_count);
+        if (edges_count == 0) {
+            continue;
+        }
+        std::vector<bool> used(edges_count, false);
+        check_trail(graph, path, used);
+        if (cycle) {
+            ASSERT_EQ(graph.from(path.front()), graph.to(path.back()));
+        }
+    }
+
+    // every trail of the decomposition needs a distinct "start" unless its component is balanced,
+    // so the minimal count is sum over components of max(1, unbalance)
+    std::vector<std::vector<size_t>> trails;
+    const size_t trails_count = eulerian_path.decompose(graph, &trails);
+    ASSERT_EQ(trails_count, trails.size());
+    std::vector<bool> used(edges_count, false);
+    for (const auto& trail : trails) {
+        check_trail(graph, trail, used);
+    }
+    for (size_t id = 0; id < edges_count; ++id) {
+        ASSERT_TRUE(used[id]);
+    }
+
+    const size_t vertices_count = graph.vertices_count();
+    std::vector<size_t> component(vertices_count);
+    for (size_t v = 0; v < vertices_count; ++v) {
+        component[v] = v;
+    }
+    const auto root = [&component](size_t v) {
+        while (component[v] != v) {
+            v = component[v];
+        }
+        return v;
+    };
+    std::vector<int64_t> balance(vertices_count, 0);
+    for (size_t edge = 0; edge < graph.edges_count(); ++edge) {
+        component[root(graph.from(edge))] = root(graph.to(edge));
+        ++balance[graph.from(edge)];
+        if (graph.is_directed()) {
+            --balance[graph.to(edge)];
+        }
+    }
+    std::vector<size_t> unbalance(vertices_count, 0);
+    std::vector<bool> has_edges(vertices_count, false);
+    for (size_t v = 0; v < vertices_count; ++v) {
+        if (graph.is_directed()) {
+            unbalance[root(v)] += static_cast<size_t>(std::max<int64_t>(balance[v], 0));
+        } else {
+            unbalance[root(v)] += static_cast<size_t>(balance[v] % 2);
+        }
+        has_edges[root(v)] = has_edges[root(v)] || !graph.edges_list(v).empty();
+    }
+    size_t expected = 0;
+    for (size_t v = 0; v < vertices_count; ++v) {
+        if (has_edges[v]) {
+            expected += std::max<size_t>(1, graph.is_directed() ? unbalance[v] : unbalance[v] / 2);
+        }
+    }
+    ASSERT_EQ(trails_count, expected);
+}
+
+}  // namespace
+
+TEST(EulerianPath, directed_matches_brute_force) {
+    for (size_t test = 0; test < 400; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 5);
+        const size_t edges_count = Random::get<size_t>(0, 8);
+        DirectedGraph<> graph(vertices_count);
+        for (size_t i = 0; i < edges_count; ++i) {
+            graph.add_directed_edge(Random::get<size_t>(0, vertices_count - 1), Random::get<size_t>(0, vertices_count - 1));
+        }
+        check_graph(graph);
+    }
+}
+
+TEST(EulerianPath, undirected_matches_brute_force) {
+    for (size_t test = 0; test < 400; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 5);
+        const size_t edges_count = Random::get<size_t>(0, 8);
+        UndirectedGraph<> graph(vertices_count);
+        for (size_t i = 0; i < edges_count; ++i) {
+            graph.add_bidirectional_edge(Random::get<size_t>(0, vertices_count - 1), Random::get<size_t>(0, vertices_count - 1));
+        }
+        check_graph(graph);
+    }
+}
+
+TEST(EulerianPath, strict_starting_vertex) {
+    DirectedGraph<> graph(3);
+    graph.add_directed_edge(0, 1);
+    graph.add_directed_edge(1, 2);
+    EulerianPath eulerian_path;
+    std::vector<size_t> path;
+    ASSERT_TRUE(eulerian_path(graph, &path, false, 0, true));
+    ASSERT_EQ(path, (std::vector<size_t>{0, 1}));
+    ASSERT_FALSE(eulerian_path(graph, &path, false, 1, true));
+    ASSERT_TRUE(eulerian_path(graph, &path, false, 1, false));
+    ASSERT_EQ(path, (std::vector<size_t>{0, 1}));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "cpplib/graph/gomory_hu_tree.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+using Edge = std::tuple<size_t, size_t, int64_t>;
+
+int64_t brute_force_min_cut(const size_t vertices_count, const std::vector<Edge>& edges, const size_t u, const size_t v) {
+    int64_t result = DinicFlow<int64_t>::weight_infinity();
+    for (size_t mask = 0; mask < (size_t(1) << vertices_count); ++mask) {
+        if (((mask >> u) & 1) == 0 || ((mask >> v) & 1) != 0) {
+            continue;
+        }
+        int64_t cut = 0;
+        for (const auto& edge : edges) {
+            if (((mask >> std::get<0>(edge)) & 1) != ((mask >> std::get<1>(edge)) & 1)) {
+                cut += std::get<2>(edge);
+            }
+        }
+        result = std::min(result, cut);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(GomoryHuTree, matches_brute_force) {
+    for (size_t test = 0; test < 100; ++test) {
+        const size_t vertices_count = Random::get<size_t>(1, 9);
+        const size_t edges_count = Random::get<size_t>(0, 2 * vertices_count);
+        DinicFlow<int64_t> network(vertices_count);
+        std::vector<Edge> edges;
+        for (size_t i = 0; i < edges_count; ++i) {
+            const size_t from = Random::get<size_t>(0, vertices_count - 1);
+            const size_t to = Random::get<size_t>(0, vertices_count - 1);
+            const int64_t capacity = Random::get<int64_t>(1, 10);
+            network.add_bidirectional_edge(from, to, capacity, capacity);
+            edges.emplace_back(from, to, capacity);
+        }
+        for (const bool parallel : {false, true}) {
+            const GomoryHuTree<int64_t> tree(network, parallel);
+            for (size_t v = 1; v < vertices_count; ++v) {
+                ASSERT_LT(tree.parent()[v], v);
+            }
+            for (size_t u = 0; u < vertices_count; ++u) {
+                ASSERT_EQ(tree.min_cut(u, u), DinicFlow<int64_t>::weight_infinity());
+                for (size_t v = u + 1; v < vertices_count; ++v) {
+                    const int64_t expected = brute_force_min_cut(vertices_count, edges, u, v);
+                    ASSERT_EQ(tree.min_cut(u, v), expected);
+                    ASSERT_EQ(tree.min_cut(v, u), expected);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/pagerank.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+DirectedGraph<> random_graph(const size_t vertices_count, const size_t edges_count) {
+    DirectedGraph<> graph(vertices_count);
+    for (size_t i = 0; i < edges_count; ++i) {
+        graph.add_directed_edge(Random::get<size_t>(0, vertices_count - 1), Random::get<size_t>(0, vertices_count - 1));
+    }
+    return graph;
+}
+
+void check_multiply(const DirectedGraph<>& graph) {
+    const size_t vertices_count = graph.vertices_count();
+    std::vector<double> x(vertices_count);
+    for (double& it : x) {
+        it = Random::get(1, 1000) / 1000.0;
+    }
+    std::vector<double> weight(graph.edges_count());
+    for (double& it : weight) {
+        it = Random::get(1, 1000) / 1000.0;
+    }
+    std::vector<double> expected(vertices_count, 0);
+    std::vector<double> expected_weighted(vertices_count, 0);
+    for (size_t edge = 0; edge < graph.edges_count(); ++edge) {
+        expected[graph.to(edge)] += x[graph.from(edge)];
+        expected_weighted[graph.to(edge)] += x[graph.from(edge)] * weight[edge];
+    }
+
+    for (const bool parallel : {false, true}) {
+        const SparseMatrixVector spmv(graph, parallel);
+        std::vector<double> edge_values(graph.edges_count());
+        for (size_t i = 0; i < edge_values.size(); ++i) {
+            edge_values[i] = weight[spmv.inbound().edge_ids()[i]];
+        }
+        std::vector<double> y(vertices_count, -1);
+        std::vector<double> y_weighted(vertices_count, -1);
+        spmv.multiply(x, y);
+        spmv.multiply(x, y_weighted, edge_values);
+        for (size_t v = 0; v < vertices_count; ++v) {
+            EXPECT_NEAR(expected[v], y[v], 1e-9);
+            EXPECT_NEAR(expected_weighted[v], y_weighted[v], 1e-9);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(SparseMatrixVector, small_graph) {
+    check_multiply(random_graph(1000, 5000));
+}
+
+TEST(SparseMatrixVector, tiled_graph) {
+    // more than kUntiledMaxVertices vertices, so the edges are split into tiles
+    check_multiply(random_graph(SparseMatrixVector::kUntiledMaxVertices + 12345, 600000));
+}
+
+TEST(PageRank, matches_dense_power_iteration) {
+    const size_t kVertices = 200;
+    const double kDamping = 0.85;
+    // a few vertices without outbound edges check the dangling mass
+    DirectedGraph<> graph(kVertices);
+    for (int i = 0; i < 1000; ++i) {
+        const size_t from = Random::get<size_t>(0, kVertices - 1);
+        if (from % 10 != 0) {
+            graph.add_directed_edge(from, Random::get<size_t>(0, kVertices - 1));
+        }
+    }
+    std::vector<double> expected(kVertices, 1.0 / kVertices);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::vector<double> next(kVertices, 0);
+        double dangling = 0;
+        for (size_t v = 0; v < kVertices; ++v) {
+            const size_t degree = graph.edges_list(v).size();
+            if (degree == 0) {
+                dangling += expected[v];
+            }
+            for (const size_t edge : graph.edges_list(v)) {
+                next[graph.to(edge)] += expected[v] / degree;
+            }
+        }
+        for (size_t v = 0; v < kVertices; ++v) {
+            next[v] = (1 - kDamping + kDamping * dangling) / kVertices + kDamping * next[v];
+        }
+        expected.swap(next);
+    }
+
+    for (const bool parallel : {false, true}) {
+        PageRank pagerank(graph, parallel);
+        EXPECT_LT(pagerank.run(kDamping, 1e-12, 1000), 1000U);
+        double sum = 0;
+        for (size_t v = 0; v < kVertices; ++v) {
+            EXPECT_NEAR(expected[v], pagerank.rank()[v], 1e-9);
+            sum += pagerank.rank()[v];
+        }
+        EXPECT_NEAR(1.0, sum, 1e-9);
+    }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "cpplib/graph/directed_graph.hpp"
+#include "cpplib/graph/transitive_closure.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+DirectedGraph<> random_dag(const size_t vertices_count, const size_t edges_count, std::vector<std::vector<bool>>* reachable) {
+    // edges go from smaller to larger labels of a random permutation, so the graph is acyclic
+    std::vector<size_t> label(vertices_count);
+    for (size_t v = 0; v < vertices_count; ++v) {
+        label[v] = v;
+    }
+    for (size_t v = vertices_count; v > 1; --v) {
+        std::swap(label[v - 1], label[Random::get<size_t>(0, v - 1)]);
+    }
+    DirectedGraph<> graph(vertices_count);
+    reachable->assign(vertices_count, std::vector<bool>(vertices_count, false));
+    for (size_t i = 0; i < edges_count; ++i) {
+        size_t from = Random::get<size_t>(0, vertices_count - 1);
+        size_t to = Random::get<size_t>(0, vertices_count - 1);
+        if (label[from] > label[to]) {
+            std::swap(from, to);
+        }
+        if (from != to) {
+            graph.add_directed_edge(from, to);
+            (*reachable)[from][to] = true;
+        }
+    }
+    for (size_t v = 0; v < vertices_count; ++v) {
+        (*reachable)[v][v] = true;
+    }
+    // Floyd-Warshall closure
+    for (size_t k = 0; k < vertices_count; ++k) {
+        for (size_t i = 0; i < vertices_count; ++i) {
+            if (!(*reachable)[i][k]) {
+                continue;
+            }
+            for (size_t j = 0; j < vertices_count; ++j) {
+                if ((*reachable)[k][j]) {
+                    (*reachable)[i][j] = true;
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+}  // namespace
+
+TEST(TransitiveClosure, build_matches_floyd_warshall) {
+    for (const size_t vertices_count : {1, 2, 63, 64, 65, 150}) {
+        std::vector<std::vector<bool>> expected;
+        const DirectedGraph<> graph = random_dag(vertices_count, 2 * vertices_count, &expected);
+        TransitiveClosure closure;
+        ASSERT_TRUE(closure.build(graph));
+        for (size_t from = 0; from < vertices_count; ++from) {
+            std::vector<size_t> vertices;
+            for (size_t to = 0; to < vertices_count; ++to) {
+                EXPECT_EQ(expected[from][to], closure.reachable(from, to));
+                if (expected[from][to]) {
+                    vertices.emplace_back(to);
+                }
+            }
+            EXPECT_EQ(vertices.size(), closure.reachable_count(from));
+            std::vector<size_t> result = closure.reachable_vertices(from);
+            std::sort(result.begin(), result.end());
+            EXPECT_EQ(vertices, result);
+        }
+    }
+}
+
+TEST(TransitiveClosure, reachable_offline) {
+    const size_t kVertices = 300;
+    std::vector<std::vector<bool>> expected;
+    const DirectedGraph<> graph = random_dag(kVertices, 600, &expected);
+    std::vector<std::pair<size_t, size_t>> queries;
+    for (int i = 0; i < 5000; ++i) {
+        queries.emplace_back(Random::get<size_t>(0, kVertices - 1), Random::get<size_t>(0, kVertices - 1));
+    }
+    for (const size_t chunk_words : {0, 1, 2, 16}) {
+        std::vector<bool> answers;
+        ASSERT_TRUE(TransitiveClosure::reachable_offline(graph, queries, &answers, chunk_words));
+        ASSERT_EQ(queries.size(), answers.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            EXPECT_EQ(expected[queries[i].first][queries[i].second], answers[i]);
+        }
+    }
+}
+
+TEST(TransitiveClosure, cycle_is_rejected) {
+    DirectedGraph<> graph(3);
+    graph.add_directed_edge(0, 1);
+    graph.add_directed_edge(1, 2);
+    graph.add_directed_edge(2, 0);
+    TransitiveClosure closure;
+    EXPECT_FALSE(closure.build(graph));
+    std::vector<bool> answers;
+    EXPECT_FALSE(TransitiveClosure::reachable_offline(graph, {{0, 1}}, &answers));
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpplib/graph/k_core.hpp"
+#include "cpplib/graph/triangles.hpp"
+#include "cpplib/graph/undirected_graph.hpp"
+#include "maths/random.hpp"
+
+namespace {
+
+UndirectedGraph<> random_graph(const size_t vertices_count, const size_t edges_count, std::vector<std::vector<bool>>* adjacent) {
+    // self-loops and parallel edges are kept in the graph, the simple graph is in adjacent
+    UndirectedGraph<> graph(vertices_count);
+    adjacent->assign(vertices_count, std::vector<bool>(vertices_count, false));
+    for (size_t i = 0; i < edges_count; ++i) {
+        const size_t from = Random::get<size_t>(0, vertices_count - 1);
+        const size_t to = Random::get<size_t>(0, vertices_count - 1);
+        graph.add_bidirectional_edge(from, to);
+        if (from != to) {
+            (*adjacent)[from][to] = (*adjacent)[to][from] = true;
+        }
+    }
+    return graph;
+}
+
+}  // namespace
+
+TEST(TriangleCounting, matches_brute_force) {
+    for (const size_t edges_count : {0, 30, 200, 800, 1700}) {
+        const size_t kVertices = 60;
+        std::vector<std::vector<bool>> adjacent;
+        const UndirectedGraph<> graph = random_graph(kVertices, edges_count, &adjacent);
+        std::vector<size_t> triangles(kVertices, 0);
+        std::vector<size_t> degree(kVertices, 0);
+        size_t total = 0;
+        for (size_t a = 0; a < kVertices; ++a) {
+            for (size_t b = 0; b < kVertices; ++b) {
+                degree[a] += adjacent[a][b];
+            }
+            for (size_t b = a + 1; b < kVertices; ++b) {
+                for (size_t c = b + 1; c < kVertices; ++c) {
+                    if (adjacent[a][b] && adjacent[b][c] && adjacent[a][c]) {
+                        ++triangles[a];
+                        ++triangles[b];
+                        ++triangles[c];
+                        ++total;
+                    }
+                }
+            }
+        }
+        for (const bool parallel : {false, true}) {
+            const TriangleCounting counting(graph, parallel);
+            EXPECT_EQ(total, counting.total_triangles());
+            EXPECT_EQ(triangles, counting.triangles());
+            EXPECT_EQ(degree, counting.degree());
+            const std::vector<double> coefficients = counting.clustering_coefficients();
+            double sum = 0;
+            for (size_t v = 0; v < kVertices; ++v) {
+                const double expected = (degree[v] < 2 ? 0.0 : 2.0 * triangles[v] / (degree[v] * (degree[v] - 1.0)));
+                EXPECT_DOUBLE_EQ(expected, coefficients[v]);
+                sum += expected;
+            }
+            EXPECT_DOUBLE_EQ(sum / kVertices, counting.average_clustering());
+        }
+    }
+}
+
+TEST(CoreDecomposition, matches_brute_force) {
+    for (const size_t edges_count : {0, 30, 200, 800, 1700}) {
+        const size_t kVertices = 60;
+        std::vector<std::vector<bool>> adjacent;
+        const UndirectedGraph<> graph = random_graph(kVertices, edges_count, &adjacent);
+        // core(v) is the largest k such that v survives repeated removal of vertices with degree < k
+        std::vector<size_t> expected(kVertices, 0);
+        size_t degeneracy = 0;
+        for (size_t k = 1; k < kVertices; ++k) {
+            std::vector<bool> alive(kVertices, true);
+            for (bool changed = true; changed; ) {
+                changed = false;
+                for (size_t v = 0; v < kVertices; ++v) {
+                    if (!alive[v]) {
+                        continue;
+                    }
+                    size_t degree = 0;
+                    for (size_t u = 0; u < kVertices; ++u) {
+                        degree += (alive[u] && adjacent[v][u]);
+                    }
+                    if (degree < k) {
+                        alive[v] = false;
+                        changed = true;
+                    }
+                }
+            }
+            for (size_t v = 0; v < kVertices; ++v) {
+                if (alive[v]) {
+                    expected[v] = k;
+                    degeneracy = k;
+                }
+            }
+        }
+        for (const bool parallel : {false, true}) {
+            std::vector<size_t> core;
+            EXPECT_EQ(degeneracy, CoreDecomposition()(graph, &core, parallel));
+            EXPECT_EQ(expected, core);
+        }
+    }
+}